@@ -0,0 +1,166 @@
+// Замер хеш-таблиц строк из trees_1
+// Сначала каждая таблица проверяется на случайной смеси add/del/find против
+// std::unordered_set. Затем на n случайных словах из строчных латинских букв
+// меряется время на операцию: вставка всех слов, поиск существующих, поиск
+// отсутствующих (та же длина слов, другие буквы) и удаление всех слов.
+// Память таблицы после вставки (байт на слово) - по счётчику malloc (glibc).
+// Отдельно - задержки отдельных вставок (p50, p99, p999, максимум): удвоение ёмкости
+// останавливает одну вставку на время переноса всех строк.
+//
+// Запуск: hash_bench [n]
+//   n - число слов (по умолчанию 10^6)
+// Компилировать с оптимизацией: g++ -O2 hash_bench.cpp
+#include <iostream>
+#include <vector>
+#include <string>
+#include <unordered_set>
+#include <memory>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdlib.h>
+#include <stdint.h>
+#include <malloc.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "../common/fast_input.h"
+#include "../trees_1/string_hash.h"
+#include "../trees_1/swiss_hash_table.h"
+#include "../trees_1/arena_hash_table.h"
+
+// В обеих программах таблица называется StringHashTable, поэтому каждая подключается
+// в своё пространство имён (их main становится обычной функцией и не вызывается)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wreturn-type"
+namespace double_hash {
+#include "../trees_1/hash_double.cpp"
+}
+// Та же таблица с постепенным удвоением
+namespace double_incremental {
+#define INCREMENTAL_REHASH
+#include "../trees_1/hash_double.cpp"
+#undef INCREMENTAL_REHASH
+}
+namespace quadratic {
+#include "../trees_1/hash_quadratic.cpp"
+}
+#pragma GCC diagnostic pop
+
+typedef std::chrono::steady_clock Clock;
+
+// Случайное слово длины 5..15; буквы берутся из [from, from + 13)
+std::string RandomWord(std::mt19937 &rnd, char from) {
+	std::string s(5 + rnd() % 11, ' ');
+	for (size_t i = 0; i < s.size(); i++) {
+		s[i] = (char)(from + rnd() % 13);
+	}
+	return s;
+}
+
+// Случайная смесь операций над маленьким словарём (много повторов и удалений)
+template<typename Table>
+bool Check(const char *name) {
+	std::mt19937 rnd(7);
+	std::vector<std::string> words;
+	for (int i = 0; i < 5000; i++) {
+		words.push_back(i % 100 == 0 ? std::string() : RandomWord(rnd, 'a').substr(0, 1 + rnd() % 6));
+	}
+	Table t;
+	std::unordered_set<std::string> ref;
+	for (int i = 0; i < 300000; i++) {
+		const std::string &s = words[rnd() % words.size()];
+		bool expected;
+		bool result;
+		switch (rnd() % 3) {
+			case 0: expected = ref.insert(s).second; result = t.add(s); break;
+			case 1: expected = ref.erase(s) > 0; result = t.del(s); break;
+			default: expected = ref.count(s) > 0; result = t.find(s); break;
+		}
+		if (expected != result) {
+			std::cout << name << "\tОШИБКА на операции " << i << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+// Время в нс на одну операцию op над всеми словами words
+template<typename Op>
+double Time(const std::vector<std::string> &words, Op op, int &ok) {
+	Clock::time_point start = Clock::now();
+	for (size_t i = 0; i < words.size(); i++) {
+		ok += op(words[i]);
+	}
+	std::chrono::duration<double, std::nano> time = Clock::now() - start;
+	return time.count() / words.size();
+}
+
+// Занято байт в куче
+size_t HeapBytes() {
+	struct mallinfo2 info = mallinfo2();
+	return info.uordblks + info.hblkhd; // большие блоки выделяются через mmap
+}
+
+template<typename Table>
+void Run(const char *name, const std::vector<std::string> &words, const std::vector<std::string> &missing) {
+	if (!Check<Table>(name)) {
+		return;
+	}
+	size_t heap = HeapBytes();
+	Table t;
+	int ok = 0;
+	double add = Time(words, [&t](const std::string &s) { return t.add(s); }, ok);
+	double memory = (double)(HeapBytes() - heap) / words.size();
+	double hit = Time(words, [&t](const std::string &s) { return t.find(s); }, ok);
+	double miss = Time(missing, [&t](const std::string &s) { return !t.find(s); }, ok);
+	double del = Time(words, [&t](const std::string &s) { return t.del(s); }, ok);
+	std::cout << name << "\tadd " << add << "\tfind hit " << hit << "\tfind miss " << miss
+		<< "\tdel " << del << " ns/op\tпамять " << memory << " байт/слово"
+		<< (ok == 4 * (int)words.size() ? "" : "\tОШИБКА: неверный результат") << std::endl;
+}
+
+// Задержки вставок всех слов в новую таблицу, нс
+template<typename Table>
+void Latency(const char *name, const std::vector<std::string> &words) {
+	Table t;
+	std::vector<double> times(words.size());
+	for (size_t i = 0; i < words.size(); i++) {
+		Clock::time_point start = Clock::now();
+		t.add(words[i]);
+		times[i] = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+	}
+	std::sort(times.begin(), times.end());
+	size_t n = times.size();
+	std::cout << name << "\tзадержка add p50 " << times[n / 2] << "\tp99 " << times[n * 99 / 100]
+		<< "\tp999 " << times[n * 999 / 1000] << "\tмакс " << times[n - 1] / 1e6 << " мс" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+	std::mt19937 rnd(n);
+	// Слова из первой половины алфавита, отсутствующие - из второй
+	std::unordered_set<std::string> unique;
+	while ((int)unique.size() < n) {
+		unique.insert(RandomWord(rnd, 'a'));
+	}
+	std::vector<std::string> words(unique.begin(), unique.end());
+	std::shuffle(words.begin(), words.end(), rnd);
+	std::vector<std::string> missing(n);
+	for (int i = 0; i < n; i++) {
+		missing[i] = RandomWord(rnd, 'n');
+	}
+
+	Run<double_hash::StringHashTable>("double", words, missing);
+	Run<double_incremental::StringHashTable>("double_incr", words, missing);
+	Run<quadratic::StringHashTable>("quadratic", words, missing);
+	Run<SwissHashTable>("swiss", words, missing);
+	Run<ArenaHashTable>("arena", words, missing);
+
+	Latency<double_hash::StringHashTable>("double", words);
+	Latency<double_incremental::StringHashTable>("double_incr", words);
+	Latency<quadratic::StringHashTable>("quadratic", words);
+	Latency<SwissHashTable>("swiss", words);
+	Latency<ArenaHashTable>("arena", words);
+}
@@ -0,0 +1,95 @@
+// Сравнение HeapQueue с std::priority_queue
+// Сценарии: построение из n элементов и извлечение всех; n вставок и n извлечений;
+// смешанный поток "вставка + извлечение" на очереди постоянного размера.
+// Компилировать с оптимизацией: g++ -O2 heap_queue_bench.cpp
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <string>
+#include <chrono>
+#include <random>
+#include <stdint.h>
+
+#include "../common/heap_queue.h"
+
+typedef std::chrono::steady_clock Clock;
+
+double Ms(Clock::time_point start) {
+	std::chrono::duration<double, std::milli> ms = Clock::now() - start;
+	return ms.count();
+}
+
+template<typename Q, typename T>
+void Run(const char *name, const std::vector<T> &data) {
+	int n = (int)data.size();
+	T sum = T();
+
+	// Построение и извлечение всех элементов
+	Clock::time_point start = Clock::now();
+	{
+		Q q(std::less<T>(), data);
+		while (!q.empty()) {
+			sum ^= q.top();
+			q.pop();
+		}
+	}
+	double build = Ms(start);
+
+	// n вставок, затем n извлечений
+	start = Clock::now();
+	{
+		Q q;
+		for (int i = 0; i < n; i++) {
+			q.push(data[i]);
+		}
+		while (!q.empty()) {
+			sum ^= q.top();
+			q.pop();
+		}
+	}
+	double pushPop = Ms(start);
+
+	// Очередь из 1000 элементов, каждая вставка сопровождается извлечением
+	start = Clock::now();
+	{
+		Q q;
+		for (int i = 0; i < n; i++) {
+			q.push(data[i]);
+			if (q.size() > 1000) {
+				sum ^= q.top();
+				q.pop();
+			}
+		}
+	}
+	double mixed = Ms(start);
+
+	std::cout << name << "\t" << n << "\tbuild+pop " << build << " ms\tpush+pop " << pushPop
+		<< " ms\tmixed " << mixed << " ms\t(" << (sum & 1) << ")" << std::endl;
+}
+
+// Обёртка с интерфейсом std::priority_queue (top/pop раздельно)
+template<typename T>
+struct HeapQueueAdapter {
+	HeapQueue<T> q;
+	HeapQueueAdapter() {}
+	HeapQueueAdapter(const std::less<T> &, const std::vector<T> &data) : q(data) {}
+	bool empty() const { return q.empty(); }
+	size_t size() const { return q.size(); }
+	const T &top() const { return q.top(); }
+	void push(const T &x) { q.push(x); }
+	void pop() { q.pop(); }
+};
+
+int main()
+{
+	std::mt19937_64 rnd(42);
+	int sizes[] = {100000, 1000000, 10000000};
+	for (int s = 0; s < 3; s++) {
+		std::vector<int64_t> data(sizes[s]);
+		for (int i = 0; i < sizes[s]; i++) {
+			data[i] = (int64_t)rnd();
+		}
+		Run<std::priority_queue<int64_t>, int64_t>("std::priority_queue", data);
+		Run<HeapQueueAdapter<int64_t>, int64_t>("HeapQueue", data);
+	}
+}
@@ -0,0 +1,54 @@
+// Сравнение вариантов пирамидальной сортировки на больших массивах
+// Для каждого размера сортируем одни и те же случайные числа двоичной кучей,
+// двоичной кучей с восходящей просейкой и 4-арной кучей, печатаем время и нс на элемент.
+// Компилировать с оптимизацией: g++ -O2 heap_sort_bench.cpp
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <stdint.h>
+
+#include "../sort_2/heap_sort.h"
+
+// Время сортировки копии v в миллисекундах, с проверкой результата
+template<typename T>
+double TimeSort(const std::vector<T> &v, HeapKind kind) {
+	std::vector<T> w(v);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	Sort(w, kind);
+	std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - start;
+
+	for (int i = 1; i < (int)w.size(); i++) {
+		if (w[i] < w[i - 1]) {
+			std::cout << "ОШИБКА: массив не отсортирован" << std::endl;
+			break;
+		}
+	}
+	return ms.count();
+}
+
+template<typename T>
+void Bench(const char *type, int n) {
+	std::mt19937_64 rnd(n);
+	std::vector<T> v(n);
+	for (int i = 0; i < n; i++) {
+		v[i] = (T)rnd();
+	}
+
+	const char *names[] = {"binary", "bottom-up", "4-ary"};
+	HeapKind kinds[] = {BINARY_HEAP, BOTTOM_UP_HEAP, QUATERNARY_HEAP};
+	for (int k = 0; k < 3; k++) {
+		double ms = TimeSort(v, kinds[k]);
+		std::cout << type << "\t" << n << "\t" << names[k] << "\t" << ms << " ms\t"
+			<< ms * 1e6 / n << " ns/elem" << std::endl;
+	}
+}
+
+int main()
+{
+	int sizes[] = {1000000, 10000000, 20000000};
+	for (int i = 0; i < 3; i++) {
+		Bench<int32_t>("int32", sizes[i]);
+		Bench<int64_t>("int64", sizes[i]);
+	}
+}
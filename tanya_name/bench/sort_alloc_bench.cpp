@@ -0,0 +1,161 @@
+// Сколько раз сортировки выделяют память при сортировке строк
+// Глобальный operator new подменён счётчиком. Строки длиной STRING_LEN не помещаются
+// во внутренний буфер std::string, поэтому каждая копия строки - это выделение ровно
+// STRING_LEN + 1 байт. Такие выделения считаем отдельно от остальных (буферы векторов
+// и т.п. - их размер кратен sizeof(std::string) и с длиной строки не совпадает).
+// Сортировки, которые перемещают элементы, а не копируют, не выделяют памяти под строки.
+//
+// Заодно проверяется, что все сортировки собираются для типа без копирования (MoveOnly).
+// Компилировать с оптимизацией: g++ -O2 -pthread sort_alloc_bench.cpp
+#include <iostream>
+#include <vector>
+#include <string>
+#include <iterator>
+#include <utility>
+#include <functional>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <new>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "../common/simd_merge.h"
+#include "../common/heap_sift.h"
+#include "../sort_2/string_sort.h"
+#include "../sort_3/parallel_merge_sort.h"
+#include "../sort_3/natural_merge_sort.h"
+
+// У пирамидальной сортировки, сортировки слиянием и быстрой сортировки одно имя - Sort
+namespace heap {
+#include "../sort_2/heap_sort.h"
+}
+namespace merge {
+#include "../sort_3/merge_sort.h"
+}
+namespace quick {
+#include "../sort_7/quick_sort.h"
+}
+
+#define STRING_LEN 40
+
+size_t allocations = 0; // Все выделения памяти
+size_t stringAllocations = 0; // Выделения под символы строк длины STRING_LEN
+
+// Подменяем все формы operator new/delete (обычные, для массивов, с размером и выравниванием),
+// чтобы каждое выделение было посчитано и освобождалось парной функцией
+void *Allocate(size_t size, size_t align = 0) {
+	allocations++;
+	if (size == STRING_LEN + 1) {
+		stringAllocations++;
+	}
+	void *p = NULL;
+	if (align > sizeof(void *)) {
+		if (posix_memalign(&p, align, size ? size : 1) != 0) {
+			p = NULL;
+		}
+	} else {
+		p = malloc(size ? size : 1);
+	}
+	if (!p) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void *operator new(size_t size) { return Allocate(size); }
+void *operator new[](size_t size) { return Allocate(size); }
+void *operator new(size_t size, std::align_val_t align) { return Allocate(size, (size_t)align); }
+void *operator new[](size_t size, std::align_val_t align) { return Allocate(size, (size_t)align); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { free(p); }
+void operator delete(void *p, size_t, std::align_val_t) noexcept { free(p); }
+void operator delete[](void *p, size_t, std::align_val_t) noexcept { free(p); }
+
+// Тип без копирования: сортировки, которые где-то копируют элементы, с ним не соберутся
+struct MoveOnly {
+	int key;
+	MoveOnly() : key(0) {}
+	explicit MoveOnly(int k) : key(k) {}
+	MoveOnly(const MoveOnly &) = delete;
+	MoveOnly &operator=(const MoveOnly &) = delete;
+	MoveOnly(MoveOnly &&) = default;
+	MoveOnly &operator=(MoveOnly &&) = default;
+	bool operator<(const MoveOnly &o) const { return key < o.key; }
+	bool operator>(const MoveOnly &o) const { return o.key < key; }
+};
+
+template<typename T>
+bool IsSorted(const std::vector<T> &v) {
+	for (size_t i = 1; i < v.size(); i++) {
+		if (v[i] < v[i - 1]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template<typename SortFn>
+void Run(const char *name, const std::vector<std::string> &data, SortFn sort) {
+	std::vector<std::string> v(data);
+	size_t all = allocations;
+	size_t strings = stringAllocations;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	sort(v);
+	std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - start;
+	std::cout << name << "\t" << v.size() << "\t" << ms.count() << " ms\tвыделений " << allocations - all
+		<< "\tиз них под строки " << stringAllocations - strings
+		<< (IsSorted(v) ? "" : "\tОШИБКА: массив не отсортирован") << std::endl;
+}
+
+template<typename SortFn>
+void RunMoveOnly(const char *name, int n, SortFn sort) {
+	std::mt19937 rnd(n);
+	std::vector<MoveOnly> v;
+	v.reserve(n);
+	for (int i = 0; i < n; i++) {
+		v.push_back(MoveOnly((int)(rnd() % 1000)));
+	}
+	sort(v);
+	if (!IsSorted(v)) {
+		std::cout << name << "\tMoveOnly\tОШИБКА: массив не отсортирован" << std::endl;
+	}
+}
+
+int main()
+{
+	std::mt19937_64 rnd(42);
+	int sizes[] = {1000, 100000, 1000000};
+	for (int s = 0; s < 3; s++) {
+		std::vector<std::string> data(sizes[s]);
+		for (int i = 0; i < sizes[s]; i++) {
+			data[i].resize(STRING_LEN);
+			for (int k = 0; k < STRING_LEN; k++) {
+				data[i][k] = (char)('a' + rnd() % 26);
+			}
+		}
+
+		Run("heap", data, [](std::vector<std::string> &v) { heap::Sort(v, heap::BINARY_HEAP); });
+		Run("heap bottom-up", data, [](std::vector<std::string> &v) { heap::Sort(v, heap::BOTTOM_UP_HEAP); });
+		Run("heap 4-ary", data, [](std::vector<std::string> &v) { heap::Sort(v, heap::QUATERNARY_HEAP); });
+		Run("merge", data, [](std::vector<std::string> &v) { merge::Sort(v); });
+		Run("natural merge", data, [](std::vector<std::string> &v) { NaturalSort(v); });
+		Run("parallel merge", data, [](std::vector<std::string> &v) { ParallelSort(v, 0); });
+		Run("quick", data, [](std::vector<std::string> &v) { quick::Sort(v); });
+		Run("multikey quick", data, [](std::vector<std::string> &v) { StringSort(v); });
+	}
+
+	for (int n = 0; n < 200; n += 7) {
+		RunMoveOnly("heap", n, [](std::vector<MoveOnly> &v) { heap::Sort(v, heap::BINARY_HEAP); });
+		RunMoveOnly("heap bottom-up", n, [](std::vector<MoveOnly> &v) { heap::Sort(v, heap::BOTTOM_UP_HEAP); });
+		RunMoveOnly("heap 4-ary", n, [](std::vector<MoveOnly> &v) { heap::Sort(v, heap::QUATERNARY_HEAP); });
+		RunMoveOnly("merge", n, [](std::vector<MoveOnly> &v) { merge::Sort(v); });
+		RunMoveOnly("natural merge", n, [](std::vector<MoveOnly> &v) { NaturalSort(v); });
+		RunMoveOnly("parallel merge", n, [](std::vector<MoveOnly> &v) { ParallelSort(v, 2); });
+		RunMoveOnly("quick", n, [](std::vector<MoveOnly> &v) { quick::Sort(v); });
+	}
+}
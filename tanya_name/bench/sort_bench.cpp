@@ -0,0 +1,270 @@
+// Общий замер всех сортировок
+// Каждая сортировка прогоняется на массивах размеров 10, 100, ... max_size и разных
+// распределений: случайные числа, отсортированные, в обратном порядке, "органная труба"
+// (возрастание, потом убывание), мало различных значений и "убийца медианы трёх" -
+// вход, на котором быстрая сортировка из sort_7 работает за квадратичное время.
+// Для каждой клетки печатается среднее время в нс на элемент, его стандартное отклонение
+// по повторам и пропускная способность, всё пишется в CSV для отслеживания регрессий.
+//
+// Запуск: sort_bench [max_size] [repeats] [csv]
+//   max_size - наибольший размер массива (по умолчанию 10^7, до 10^9 при достатке памяти)
+//   repeats - число повторов каждого замера (по умолчанию 5)
+//   csv - файл результатов (по умолчанию sort_bench.csv)
+// Компилировать с оптимизацией: g++ -O2 -pthread sort_bench.cpp
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <iterator>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "../common/simd_merge.h"
+#include "../common/heap_sift.h"
+#include "../common/external_sort.h"
+#include "../sort_3/parallel_merge_sort.h"
+#include "../sort_3/natural_merge_sort.h"
+#include "../common/adaptive_sort.h"
+#include "../common/fast_input.h"
+#include "../common/parallel_writer.h"
+
+// Все программы называют свою сортировку Sort, поэтому каждая подключается в своё
+// пространство имён. main программ из sort_1 и sort_6 при этом становится обычной
+// функцией этого пространства имён и не вызывается (предупреждение о том, что такая
+// функция ничего не возвращает, для них отключено).
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wreturn-type"
+namespace bubble {
+#include "../sort_1/bubble_sort.cpp"
+}
+namespace insertion {
+#include "../sort_1/insertion_sort.cpp"
+}
+namespace selection {
+#include "../sort_1/selection_sort.cpp"
+}
+namespace heap {
+#include "../sort_2/heap_sort.h"
+}
+namespace merge {
+#include "../sort_3/merge_sort.h"
+}
+namespace binary {
+#include "../sort_6/binary_quicksort.cpp"
+}
+// Быстрая сортировка (sort_7) уже подключена через adaptive_sort.h
+namespace quick {
+using ::Sort;
+}
+#pragma GCC diagnostic pop
+
+// Если один прогон сортировки занял больше, на следующих размерах этого распределения
+// она не запускается (квадратичные сортировки на больших массивах)
+#define TIME_LIMIT_MS 2000
+// Маленькие массивы сортируем пачкой копий, чтобы время прогона было много больше
+// точности часов: в пачке не меньше BATCH_ELEMENTS элементов
+#define BATCH_ELEMENTS (100 * 1000)
+// Строить "убийцу медианы трёх" - квадратичная работа, больших размеров не строим
+#define KILLER_MAX_SIZE (100 * 1000)
+
+typedef std::chrono::steady_clock Clock;
+
+// Обёртки для вариантов с дополнительными параметрами
+void HeapSort(std::vector<int> &v) { heap::Sort(v, heap::BINARY_HEAP); }
+void HeapSortBottomUp(std::vector<int> &v) { heap::Sort(v, heap::BOTTOM_UP_HEAP); }
+void HeapSort4(std::vector<int> &v) { heap::Sort(v, heap::QUATERNARY_HEAP); }
+void ParallelMergeSort(std::vector<int> &v) { ParallelSort(v, 0); }
+void AdaptiveUnstableSort(std::vector<int> &v) { AdaptiveSort(v, false); }
+void StdSort(std::vector<int> &v) { std::sort(v.begin(), v.end()); }
+
+// Время сортировки batch копий data в наносекундах на элемент.
+// T - тип элементов сортировки (данные переводятся в него до замера).
+// Результат сверяется с sorted; false - сортировка ошиблась.
+template<typename T, void (*SortFn)(std::vector<T> &)>
+bool TimeSort(const std::vector<int> &data, const std::vector<int> &sorted, int batch, double &ns) {
+	std::vector<std::vector<T> > copies(batch, std::vector<T>(data.begin(), data.end()));
+	Clock::time_point start = Clock::now();
+	for (int b = 0; b < batch; b++) {
+		SortFn(copies[b]);
+	}
+	std::chrono::duration<double, std::nano> time = Clock::now() - start;
+	ns = time.count() / ((double)batch * data.size());
+
+	for (size_t i = 0; i < sorted.size(); i++) {
+		if (copies[0][i] != (T)sorted[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+struct Engine {
+	const char *name;
+	bool (*time)(const std::vector<int> &data, const std::vector<int> &sorted, int batch, double &ns);
+};
+
+Engine engines[] = {
+	{"bubble", TimeSort<int, bubble::Sort>},
+	{"insertion", TimeSort<int, insertion::Sort>},
+	{"selection", TimeSort<int, selection::Sort>},
+	{"heap", TimeSort<int, HeapSort>},
+	{"heap bottom-up", TimeSort<int, HeapSortBottomUp>},
+	{"heap 4-ary", TimeSort<int, HeapSort4>},
+	{"merge", TimeSort<int, merge::Sort<int> >},
+	{"natural merge", TimeSort<int, NaturalSort<int> >},
+	{"parallel merge", TimeSort<int, ParallelMergeSort>},
+	{"binary quicksort", TimeSort<int64_t, binary::Sort>},
+	{"quick", TimeSort<int, quick::Sort<int> >},
+	{"adaptive", TimeSort<int, AdaptiveUnstableSort>},
+	{"std::sort", TimeSort<int, StdSort>},
+};
+
+
+// "Убийца медианы трёх": противник МакИлроя. Сортируем номера элементов, значения которых
+// ещё не выбраны ("газ", больше любого выбранного). Когда сравниваются два газа, один из них
+// "замерзает" - получает следующее по порядку значение; замерзает тот, который похож
+// на опорный элемент (участвовал в предыдущем сравнении с газом). Так опорным элементом
+// всегда оказывается почти минимум, и быстрая сортировка делит массив на 1 и n - 2.
+// Значения, выбранные за время сортировки, и есть плохой вход для этой сортировки.
+// Алгоритм: McIlroy - A Killer Adversary for Quicksort
+// http://www.cs.dartmouth.edu/~doug/mdmspe.pdf
+namespace adversary {
+	std::vector<int> val;
+	int gas;
+	int solid;
+	int candidate;
+
+	inline int Compare(int x, int y) {
+		if (val[x] == gas && val[y] == gas) {
+			if (x == candidate) {
+				val[x] = solid++;
+			} else {
+				val[y] = solid++;
+			}
+		}
+		if (val[x] == gas) {
+			candidate = x;
+		} else if (val[y] == gas) {
+			candidate = y;
+		}
+		return val[x] - val[y];
+	}
+
+	struct Item {
+		int i;
+		bool operator<(const Item &o) const { return Compare(i, o.i) < 0; }
+		bool operator>(const Item &o) const { return Compare(i, o.i) > 0; }
+	};
+}
+
+std::vector<int> MedianOf3Killer(int n) {
+	adversary::val.assign(n, n);
+	adversary::gas = n;
+	adversary::solid = 0;
+	adversary::candidate = -1;
+	std::vector<adversary::Item> items(n);
+	for (int i = 0; i < n; i++) {
+		items[i].i = i;
+	}
+	quick::Sort(items);
+	return adversary::val;
+}
+
+// Распределения входных данных
+const char *distributions[] = {"random", "sorted", "reversed", "organ-pipe", "few-unique", "median-of-3-killer"};
+const int DISTRIBUTIONS = sizeof(distributions) / sizeof(distributions[0]);
+
+// Массив распределения d размера n; false - такой массив не строится
+bool Generate(int d, int n, std::vector<int> &v) {
+	std::mt19937 rnd(n);
+	v.resize(n);
+	switch (d) {
+		case 0: for (int i = 0; i < n; i++) v[i] = (int)(rnd() % 1000000000); break;
+		case 1: for (int i = 0; i < n; i++) v[i] = i; break;
+		case 2: for (int i = 0; i < n; i++) v[i] = n - i; break;
+		case 3: for (int i = 0; i < n; i++) v[i] = i < n / 2 ? i : n - i; break;
+		case 4: for (int i = 0; i < n; i++) v[i] = (int)(rnd() % 16); break;
+		case 5:
+			if (n > KILLER_MAX_SIZE) {
+				return false;
+			}
+			v = MedianOf3Killer(n);
+			break;
+	}
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	long long maxSize = argc > 1 ? atoll(argv[1]) : 10000000;
+	int repeats = argc > 2 ? atoi(argv[2]) : 5;
+	const char *csvName = argc > 3 ? argv[3] : "sort_bench.csv";
+	if (repeats < 1) {
+		repeats = 1;
+	}
+
+	std::ofstream csv(csvName);
+	csv << "engine,distribution,size,repeats,ns_per_elem,stddev_ns_per_elem,min_ns_per_elem,melem_per_s" << std::endl;
+
+	const int ENGINES = sizeof(engines) / sizeof(engines[0]);
+	// tooSlow[e][d] - сортировка e уже превысила TIME_LIMIT_MS на распределении d
+	std::vector<std::vector<bool> > tooSlow(ENGINES, std::vector<bool>(DISTRIBUTIONS, false));
+
+	std::vector<int> data;
+	for (long long n = 10; n <= maxSize; n *= 10) {
+		for (int d = 0; d < DISTRIBUTIONS; d++) {
+			if (!Generate(d, (int)n, data)) {
+				continue;
+			}
+			std::vector<int> sorted(data);
+			std::sort(sorted.begin(), sorted.end());
+			int batch = n < BATCH_ELEMENTS ? (int)(BATCH_ELEMENTS / n) : 1;
+
+			for (int e = 0; e < ENGINES; e++) {
+				if (tooSlow[e][d]) {
+					continue;
+				}
+				// Среднее, отклонение и минимум по повторам
+				double sum = 0;
+				double sum2 = 0;
+				double best = 0;
+				int runs = 0;
+				bool ok = true;
+				while (runs < repeats && ok) {
+					double ns = 0;
+					ok = engines[e].time(data, sorted, batch, ns);
+					sum += ns;
+					sum2 += ns * ns;
+					best = (runs == 0 || ns < best) ? ns : best;
+					runs++;
+					// Слишком долго - больше не повторяем и больших размеров не пробуем
+					if (ns * n * batch > TIME_LIMIT_MS * 1e6) {
+						tooSlow[e][d] = true;
+						break;
+					}
+				}
+				if (!ok) {
+					std::cout << engines[e].name << "\t" << distributions[d] << "\t" << n
+						<< "\tОШИБКА: массив не отсортирован" << std::endl;
+					continue;
+				}
+				double mean = sum / runs;
+				double var = sum2 / runs - mean * mean;
+				double dev = var > 0 ? sqrt(var) : 0;
+				double throughput = 1e3 / mean; // миллионов элементов в секунду
+
+				std::cout << engines[e].name << "\t" << distributions[d] << "\t" << n << "\t"
+					<< mean << " ± " << dev << " ns/elem\t" << throughput << " M/s" << std::endl;
+				csv << engines[e].name << "," << distributions[d] << "," << n << "," << runs << ","
+					<< mean << "," << dev << "," << best << "," << throughput << std::endl;
+			}
+		}
+	}
+}
@@ -0,0 +1,159 @@
+// Замер хеширования строк из trees_1/string_hash.cpp
+// Сначала WordHashSerial и WordHashLanes сверяются с прямым вычислением многочлена
+// (остаток 128-бит чисел) на случайных строках длины 0..300.
+// Скорость: нс на строку и ГБ/с для строк разной длины - PolynomialHash (прежний),
+// WordHashSerial (одна цепочка) и WordHash (4 цепочки со строк WORD_HASH_LANES_FROM байт).
+// Распределение: число разных хешей (из n) и хи-квадрат по 2^16 корзинам (старшие биты
+// a * h + b, как в таблицах), делённый на число степеней свободы - у равномерного около 1.
+// Наборы: случайные слова из строчных латинских букв и ключи "key" + 8 цифр.
+//
+// Запуск: string_hash_bench [n]
+//   n - число строк в наборах для распределения (по умолчанию 10^6)
+// Компилировать с оптимизацией: g++ -O2 string_hash_bench.cpp
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "../trees_1/string_hash.h"
+
+typedef std::chrono::steady_clock Clock;
+
+// Многочлен WordHash напрямую: начальная единица, куски по 7 байт, в старшем байте
+// последнего - его длина; остатки 128-бит чисел
+uint64_t ReferenceHash(const std::string &s, uint64_t c) {
+	const __uint128_t p = P61;
+	__uint128_t h = 1;
+	for (size_t pos = 0; pos < s.size(); pos += 7) {
+		uint64_t x = 0;
+		for (size_t j = pos; j < pos + 7 && j < s.size(); j++) {
+			x |= (uint64_t)(unsigned char)s[j] << (8 * (j - pos));
+		}
+		if (pos + 7 >= s.size()) {
+			x |= (uint64_t)(s.size() - pos) << 56;
+		}
+		h = (h + x) * c % p;
+	}
+	return (uint64_t)h;
+}
+
+bool Check() {
+	std::mt19937_64 rnd(1);
+	for (int i = 0; i < 20000; i++) {
+		std::string s(rnd() % 301, ' ');
+		for (size_t j = 0; j < s.size(); j++) {
+			s[j] = (char)rnd();
+		}
+		uint64_t c = (rnd() >> 3) | 1;
+		uint64_t expected = ReferenceHash(s, c);
+		if (WordHashSerial(s.data(), s.size(), c) != expected || WordHashLanes(s.data(), s.size(), c) != expected) {
+			std::cout << "ОШИБКА: неверный хеш строки длины " << s.size() << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+// Время в нс на хеширование одной строки
+template<typename Hash>
+double Time(const std::vector<std::string> &strings, Hash hash, uint64_t &sum) {
+	Clock::time_point start = Clock::now();
+	for (int repeat = 0; repeat < 5; repeat++) {
+		for (size_t i = 0; i < strings.size(); i++) {
+			sum += hash(strings[i]);
+		}
+	}
+	std::chrono::duration<double, std::nano> time = Clock::now() - start;
+	return time.count() / (5 * strings.size());
+}
+
+void Speed(size_t length, uint64_t c) {
+	std::mt19937 rnd((unsigned)length);
+	// Около 16 МБ строк, но не меньше 1000 штук
+	std::vector<std::string> strings(std::max<size_t>(1000, (16 << 20) / (length + 32)));
+	for (size_t i = 0; i < strings.size(); i++) {
+		strings[i].resize(length);
+		for (size_t j = 0; j < length; j++) {
+			strings[i][j] = (char)('a' + rnd() % 26);
+		}
+	}
+	std::vector<uint64_t> coeffs;
+	uint64_t sum = 0;
+	double polynomial = Time(strings, [c, &coeffs](const std::string &s) { return PolynomialHash(s, c, coeffs); }, sum);
+	double serial = Time(strings, [c](const std::string &s) { return WordHashSerial(s.data(), s.size(), c); }, sum);
+	double word = Time(strings, [c](const std::string &s) { return WordHash(s, c); }, sum);
+	printf("%6zu байт\tPolynomialHash %8.1f нс %5.2f ГБ/с\tWordHashSerial %8.1f нс %5.2f ГБ/с"
+		"\tWordHash %8.1f нс %5.2f ГБ/с%s\n",
+		length, polynomial, length / polynomial, serial, length / serial, word, length / word,
+		sum == 1 ? " " : ""); // sum - чтобы хеширование не выбросил оптимизатор
+}
+
+// Разных хешей и хи-квадрат на степень свободы по 2^16 корзинам
+template<typename Hash>
+void Distribution(const char *name, const std::vector<std::string> &strings, Hash hash, uint64_t a, uint64_t b) {
+	const int BITS = 16;
+	std::vector<uint64_t> h(strings.size());
+	std::vector<double> buckets(1 << BITS);
+	for (size_t i = 0; i < strings.size(); i++) {
+		h[i] = hash(strings[i]);
+		buckets[(a * h[i] + b) >> (64 - BITS)]++;
+	}
+	std::sort(h.begin(), h.end());
+	size_t distinct = std::unique(h.begin(), h.end()) - h.begin();
+	double expected = (double)strings.size() / buckets.size();
+	double chi2 = 0;
+	for (size_t i = 0; i < buckets.size(); i++) {
+		chi2 += (buckets[i] - expected) * (buckets[i] - expected) / expected;
+	}
+	printf("  %-16s разных хешей %zu из %zu\tхи-квадрат %.3f\n",
+		name, distinct, strings.size(), chi2 / (buckets.size() - 1));
+}
+
+void Distributions(const char *title, const std::vector<std::string> &strings, uint64_t c, uint64_t a, uint64_t b) {
+	std::cout << title << std::endl;
+	std::vector<uint64_t> coeffs;
+	Distribution("PolynomialHash", strings, [c, &coeffs](const std::string &s) { return PolynomialHash(s, c, coeffs); }, a, b);
+	Distribution("WordHash", strings, [c](const std::string &s) { return WordHash(s, c); }, a, b);
+}
+
+int main(int argc, char **argv)
+{
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+	if (!Check()) {
+		return 1;
+	}
+	srand(n);
+	uint64_t a = GetRand64();
+	uint64_t b = GetRand64();
+	uint64_t c = (GetRand64() >> 3) | 1; // Должно быть не больше 2^61 - 1
+
+	size_t lengths[] = {4, 8, 12, 16, 32, 64, 256, 4096};
+	for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+		Speed(lengths[i], c);
+	}
+
+	std::mt19937 rnd(n);
+	std::vector<std::string> words(n);
+	for (int i = 0; i < n; i++) {
+		words[i].resize(5 + rnd() % 11);
+		for (size_t j = 0; j < words[i].size(); j++) {
+			words[i][j] = (char)('a' + rnd() % 26);
+		}
+	}
+	std::sort(words.begin(), words.end());
+	words.erase(std::unique(words.begin(), words.end()), words.end());
+	Distributions("Случайные слова:", words, c, a, b);
+
+	std::vector<std::string> keys(n);
+	char key[16];
+	for (int i = 0; i < n; i++) {
+		snprintf(key, sizeof(key), "key%08d", i);
+		keys[i] = key;
+	}
+	Distributions("Ключи key00000000...:", keys, c, a, b);
+}
@@ -0,0 +1,214 @@
+// Сортировка с выбором алгоритма по входу
+// Вместо того чтобы выбирать сортировку вручную, смотрим на сам массив:
+// - размер: до 6 элементов - сортирующая сеть (sort_7), до ADAPTIVE_INSERTION_SIZE - вставки;
+// - упорядоченность: число монотонных серий (за тот же проход, что и min/max).
+//   Уже отсортированный массив не трогаем, при малом числе серий (почти отсортированный,
+//   обратный, "органная труба") - естественная сортировка слиянием (sort_3),
+//   она линейна на длинных сериях;
+// - устойчивость: если нужна - сортировка слиянием (sort_3), параллельная на больших массивах;
+// - ширина ключа: для целых min/max дают число значащих бит (у всех чисел между min и max
+//   одинаковые старшие биты). Мало бит - поразрядная сортировка (бинарный QuickSort, sort_6)
+//   только по этим битам, за O(n * бит) вместо O(n log n);
+// - доля повторов в выборке (смотрим, только когда от неё зависит выбор): при большом
+//   числе повторов поразрядная сортировка выгодна и при большей ширине ключа;
+// - иначе быстрая сортировка (sort_7) с пределом глубины и пирамидальной сортировкой
+//   на случай плохого для неё входа (интроспективная сортировка).
+// Каждое решение передаётся в обработчик SortDecisionHook (если он задан) - так можно
+// проверить, что и почему выбрано, не меняя кода сортировки.
+#include <vector>
+#include <utility>
+#include <thread>
+#include <type_traits>
+#include <stdint.h>
+
+#include "../sort_3/natural_merge_sort.h"
+#include "../sort_3/parallel_merge_sort.h"
+#include "../sort_6/binary_sort.h"
+#include "../sort_7/quick_sort.h"
+
+// Куски до этого размера сортируем вставками
+#define ADAPTIVE_INSERTION_SIZE 16
+// Почти отсортирован: серий не больше 1 / ADAPTIVE_RUNS_RATIO от размера
+#define ADAPTIVE_RUNS_RATIO 64
+// Меньше этого размера поразрядная сортировка не окупает проходов по битам
+#define ADAPTIVE_RADIX_MIN_SIZE 4096
+// Сколько элементов берём в выборку для оценки повторов
+#define ADAPTIVE_SAMPLE_SIZE 64
+
+// Решение, принятое AdaptiveSort
+struct SortDecision {
+	const char *engine; // "none", "network", "insertion", "natural merge", "parallel merge", "radix", "quick"
+	size_t size;
+	bool stable; // Требовалась ли устойчивость
+	int keyBits; // Значащих бит ключа (между min и max), -1 - ключ не целый
+	size_t runs; // Число монотонных серий (неубывающих и убывающих)
+	double duplicates; // Доля повторов в выборке, -1 - выборка не понадобилась
+};
+
+typedef void (*SortDecisionHook)(const SortDecision &decision);
+
+// Текущий обработчик решений (0 - не задан)
+inline SortDecisionHook &DecisionHook() {
+	static SortDecisionHook hook = 0;
+	return hook;
+}
+
+inline void SetSortDecisionHook(SortDecisionHook hook) {
+	DecisionHook() = hook;
+}
+
+// Сортировка вставками (как в sort_1/insertion_sort.cpp, с перемещением элементов)
+template<typename T>
+void InsertionSort(T *v, int n) {
+	for (int i = 1; i < n; i++) {
+		T key = std::move(v[i]);
+		int j = i - 1;
+		while (j >= 0 && key < v[j]) {
+			v[j + 1] = std::move(v[j]);
+			--j;
+		}
+		v[j + 1] = std::move(key);
+	}
+}
+
+// Доля повторов среди ADAPTIVE_SAMPLE_SIZE элементов, взятых через равные промежутки.
+// Сортируются указатели, а не сами элементы - копировать T не нужно.
+template<typename T>
+double SampleDuplicates(const std::vector<T> &v) {
+	int n = (int)v.size();
+	int s = n < ADAPTIVE_SAMPLE_SIZE ? n : ADAPTIVE_SAMPLE_SIZE;
+	std::vector<const T *> sample(s);
+	for (int i = 0; i < s; i++) {
+		sample[i] = &v[(int64_t)n * i / s];
+	}
+	for (int i = 1; i < s; i++) {
+		const T *key = sample[i];
+		int j = i - 1;
+		while (j >= 0 && *key < *sample[j]) {
+			sample[j + 1] = sample[j];
+			--j;
+		}
+		sample[j + 1] = key;
+	}
+	int equal = 0;
+	for (int i = 1; i < s; i++) {
+		if (!(*sample[i - 1] < *sample[i])) {
+			equal++;
+		}
+	}
+	return s > 1 ? (double)equal / (s - 1) : 0;
+}
+
+// Число бит от старшего различающегося бита min и max до младшего
+template<typename T>
+int KeyBits(T lo, T hi) {
+	typedef typename std::make_unsigned<T>::type U;
+	U x = (U)lo ^ (U)hi;
+	int bits = 0;
+	while (x != 0) {
+		bits++;
+		x >>= 1;
+	}
+	return bits;
+}
+
+inline int Log2(size_t n) {
+	int r = 0;
+	while (n > 1) {
+		r++;
+		n >>= 1;
+	}
+	return r;
+}
+
+// stable - сохранить порядок равных элементов
+template<typename T> void AdaptiveSort(std::vector<T> &v, bool stable = false) {
+	SortDecision d;
+	d.engine = "none";
+	d.size = v.size();
+	d.stable = stable;
+	d.keyBits = -1;
+	d.runs = 0;
+	d.duplicates = -1;
+	int n = (int)v.size();
+
+	if (n > 1 && n <= MIN_LIST_SIZE && !stable) {
+		d.engine = "network";
+		T *p = &v[0];
+		switch (n) {
+			case 2: sort2(p); break;
+			case 3: sort3(p); break;
+			case 4: sort4(p); break;
+			case 5: sort5(p); break;
+			case 6: sort6(p); break;
+		}
+	} else if (n > 1 && n <= ADAPTIVE_INSERTION_SIZE) {
+		d.engine = "insertion";
+		InsertionSort(&v[0], n);
+	} else if (n > 1) {
+		// Один проход: серии и (для целых) min/max.
+		// Новая серия начинается там, где меняется направление: v[i] < v[i - 1] или нет.
+		size_t descents = 0;
+		size_t runs = 1;
+		bool down = v[1] < v[0];
+		for (int i = 1; i < n; i++) {
+			bool less = v[i] < v[i - 1];
+			descents += less;
+			runs += (less != down);
+			down = less;
+		}
+		d.runs = runs;
+		int bits = -1;
+		if constexpr (std::is_integral<T>::value) {
+			T lo = v[0];
+			T hi = v[0];
+			for (int i = 1; i < n; i++) {
+				lo = v[i] < lo ? v[i] : lo;
+				hi = hi < v[i] ? v[i] : hi;
+			}
+			bits = KeyBits(lo, hi);
+		}
+		d.keyBits = bits;
+
+		size_t few = (size_t)n / ADAPTIVE_RUNS_RATIO;
+		int cores = (int)std::thread::hardware_concurrency();
+		if (descents == 0) {
+			d.engine = "none"; // Уже отсортирован
+		} else if (runs <= few) {
+			d.engine = "natural merge";
+			NaturalSort(v);
+		} else if (stable) {
+			if (n >= PARALLEL_MIN_SIZE && cores > 1) {
+				d.engine = "parallel merge";
+				ParallelSort(v, cores);
+			} else {
+				d.engine = "natural merge";
+				NaturalSort(v);
+			}
+		} else {
+			int logn = Log2((size_t)n);
+			// Ключ не короче T целиком - числа разных знаков, старшие биты не общие
+			bool radix = n >= ADAPTIVE_RADIX_MIN_SIZE && bits >= 0 && bits < (int)sizeof(T) * 8 && bits <= 2 * logn;
+			if (radix && bits > logn) {
+				d.duplicates = SampleDuplicates(v);
+				radix = d.duplicates >= 0.5;
+			}
+			if constexpr (std::is_integral<T>::value) {
+				if (radix) {
+					d.engine = "radix";
+					// Старшие sizeof(T) * 8 - bits бит у всех одинаковые - их не смотрим
+					Partition(v, 0, n - 1, (int)sizeof(T) * 8 - bits);
+				}
+			}
+			if (!radix) {
+				d.engine = "quick";
+				// С пределом глубины 2 log n: на плохом входе - пирамидальная сортировка
+				quickSort(v, 0, n - 1, 2 * logn);
+			}
+		}
+	}
+
+	if (DecisionHook()) {
+		DecisionHook()(d);
+	}
+}
@@ -0,0 +1,8 @@
+#ifndef ADAPTIVE_SORT_INCLUDED
+#define ADAPTIVE_SORT_INCLUDED
+
+#include "adaptive_sort.cpp"
+
+template<typename T> void AdaptiveSort(std::vector<T> &v, bool stable);
+
+#endif
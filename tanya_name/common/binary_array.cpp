@@ -0,0 +1,146 @@
+// Двоичный формат последовательности чисел
+// Текстовый вход из сотен миллионов чисел разбирается секунды, и так при каждом запуске.
+// Двоичный файл хранит ту же последовательность уже разобранной:
+//   заголовок, 16 байт: "TNBA", тип элементов (BINARY_INT32 / BINARY_INT64),
+//   флаг упорядоченности (вся последовательность неубывающая), 2 байта резерва,
+//   число элементов (uint64);
+//   дальше сами числа подряд, little-endian.
+// Последовательность та же, что в текстовом файле, вместе с размерами в начале входа
+// (n, k и т.п.), поэтому программы читают двоичный файл тем же кодом, что и текстовый:
+// FastInput узнаёт формат по заголовку и отдаёт числа из отображённого в память файла
+// без всякого разбора. Перевод между форматами - tools/binary_convert.cpp.
+#include <vector>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#define BINARY_MAGIC "TNBA"
+// Сколько элементов BinaryWriter копит перед записью в файл
+#define BINARY_WRITE_BUFFER (64 * 1024)
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define BINARY_HOST_LITTLE_ENDIAN 0
+#else
+#define BINARY_HOST_LITTLE_ENDIAN 1
+#endif
+
+enum BinaryType {
+	BINARY_INT32 = 1,
+	BINARY_INT64 = 2
+};
+
+struct BinaryHeader {
+	char magic[4];
+	uint8_t type;
+	uint8_t sorted;
+	uint16_t reserved;
+	uint64_t count;
+};
+
+static_assert(sizeof(BinaryHeader) == 16, "заголовок двоичного файла - 16 байт");
+
+// Размер элемента в байтах, 0 - неизвестный тип
+inline size_t BinaryElementSize(int type) {
+	return type == BINARY_INT32 ? 4 : (type == BINARY_INT64 ? 8 : 0);
+}
+
+// Перевод между little-endian и порядком байт машины (на little-endian ничего не делает)
+inline uint32_t LittleEndian(uint32_t x) { return BINARY_HOST_LITTLE_ENDIAN ? x : __builtin_bswap32(x); }
+inline uint64_t LittleEndian(uint64_t x) { return BINARY_HOST_LITTLE_ENDIAN ? x : __builtin_bswap64(x); }
+
+// Элемент типа type по адресу p (выравнивание не требуется)
+inline int64_t LoadBinary(const char *p, int type) {
+	if (type == BINARY_INT32) {
+		uint32_t x;
+		memcpy(&x, p, 4);
+		return (int32_t)LittleEndian(x);
+	}
+	uint64_t x;
+	memcpy(&x, p, 8);
+	return (int64_t)LittleEndian(x);
+}
+
+// Разобрать заголовок в начале куска [p, p + size).
+// false - это не двоичный файл (нет подписи, неизвестный тип или файл короче заявленного).
+inline bool ParseBinaryHeader(const char *p, size_t size, BinaryHeader &h) {
+	if (size < sizeof(BinaryHeader)) {
+		return false;
+	}
+	memcpy(&h, p, sizeof(BinaryHeader));
+	h.count = LittleEndian(h.count);
+	size_t elem = BinaryElementSize(h.type);
+	return memcmp(h.magic, BINARY_MAGIC, 4) == 0 && elem > 0
+		&& h.count <= (size - sizeof(BinaryHeader)) / elem;
+}
+
+// Запись последовательности в двоичном формате по одному числу.
+// Число элементов и упорядоченность известны только в конце, поэтому заголовок
+// переписывается в Close - f должен быть обычным файлом (не каналом).
+class BinaryWriter {
+	FILE *f;
+	int type;
+	long start; // Где в файле заголовок
+	uint64_t count;
+	bool sorted;
+	int64_t last;
+	std::vector<char> buf;
+	size_t used;
+
+	bool Flush() {
+		bool ok = used == 0 || fwrite(&buf[0], 1, used, f) == used;
+		used = 0;
+		return ok;
+	}
+
+	bool WriteHeader() {
+		BinaryHeader h;
+		memcpy(h.magic, BINARY_MAGIC, 4);
+		h.type = (uint8_t)type;
+		h.sorted = sorted ? 1 : 0;
+		h.reserved = 0;
+		h.count = LittleEndian(count);
+		return fwrite(&h, sizeof(h), 1, f) == 1;
+	}
+
+public:
+	BinaryWriter(FILE *file, int elementType)
+		: f(file), type(elementType), count(0), sorted(true), last(0),
+		  buf(BINARY_WRITE_BUFFER * BinaryElementSize(elementType)), used(0) {
+		start = ftell(f);
+		WriteHeader(); // Пока с нулевым числом элементов
+	}
+
+	// false - число не помещается в тип элементов
+	bool Write(int64_t x) {
+		if (type == BINARY_INT32 && (x < INT32_MIN || x > INT32_MAX)) {
+			return false;
+		}
+		if (used == buf.size() && !Flush()) {
+			return false;
+		}
+		if (type == BINARY_INT32) {
+			uint32_t le = LittleEndian((uint32_t)(int32_t)x);
+			memcpy(&buf[used], &le, 4);
+			used += 4;
+		} else {
+			uint64_t le = LittleEndian((uint64_t)x);
+			memcpy(&buf[used], &le, 8);
+			used += 8;
+		}
+		sorted = sorted && (count == 0 || last <= x);
+		last = x;
+		count++;
+		return true;
+	}
+
+	uint64_t Count() const { return count; }
+	bool Sorted() const { return sorted; }
+
+	// Дописать остаток и настоящий заголовок. false - ошибка записи.
+	bool Close() {
+		if (!Flush() || fseek(f, start, SEEK_SET) != 0 || !WriteHeader()) {
+			return false;
+		}
+		return fseek(f, 0, SEEK_END) == 0 && fflush(f) == 0;
+	}
+};
@@ -0,0 +1,6 @@
+#ifndef BINARY_ARRAY_INCLUDED
+#define BINARY_ARRAY_INCLUDED
+
+#include "binary_array.cpp"
+
+#endif
@@ -0,0 +1,48 @@
+// Перевод дат в порядковые номера дней (число дней от 1 марта 0 года)
+// Номера соседних дней отличаются на 1, поэтому по ним можно строить плотные массивы
+// по календарю, а разность номеров - это число дней между датами.
+// Алгоритм days_from_civil: http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+// Несуществующие даты (например, 29 февраля невисокосного года) переходят на следующие дни.
+// Если нужен тот же порядок, что у упакованных дат d + m * 100 + y * 10000, - см. HalfDayOrdinal.
+
+// Число дней в месяце m года y
+inline int DaysInMonth(int m, int y) {
+	static const int days[13] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+	if (m == 2 && (y % 4 == 0 && (y % 100 != 0 || y % 400 == 0))) {
+		return 29;
+	}
+	return days[m];
+}
+
+// Номер дня для даты d.m.y
+inline int DayOrdinal(int d, int m, int y) {
+	// Год начинаем с марта - тогда 29 февраля оказывается в конце года
+	if (m <= 2) {
+		y--;
+	}
+	int era = (y >= 0 ? y : y - 399) / 400;
+	int yoe = y - era * 400; // Год эры [0, 399]
+	int doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1; // День года [0, 365]
+	int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy; // День эры [0, 146096]
+	return era * 146097 + doe;
+}
+
+// Номер дня для даты в формате d + m * 100 + y * 10000 (как в contemporaries)
+inline int DayOrdinal(int date) {
+	return DayOrdinal(date % 100, (date / 100) % 100, date / 10000);
+}
+
+// Номер полудня для даты в формате d + m * 100 + y * 10000: у существующей даты - 2 * DayOrdinal.
+// Несуществующий день за концом месяца (29 февраля невисокосного года - 18-летие
+// родившегося 29 февраля) получает нечётный номер между последним днём месяца и первым
+// числом следующего. Так номера упорядочены так же, как сами упакованные даты.
+inline int HalfDayOrdinal(int date) {
+	int d = date % 100;
+	int m = (date / 100) % 100;
+	int y = date / 10000;
+	int last = DaysInMonth(m, y);
+	if (d > last) {
+		return 2 * DayOrdinal(last, m, y) + 1;
+	}
+	return 2 * DayOrdinal(d, m, y);
+}
@@ -0,0 +1,6 @@
+#ifndef CALENDAR_INCLUDED
+#define CALENDAR_INCLUDED
+
+#include "calendar.cpp"
+
+#endif
@@ -0,0 +1,134 @@
+// Быстрый разбор дат "день месяц год" поверх FastInput (common/fast_input.cpp)
+// Чтение каждой даты тремя std::cin >> стоит дороже, чем сама обработка дат.
+// Здесь даты разбираются по указателю в буфере FastInput:
+// - быстрый путь для типичной записи "Д[Д] М[М] ГГГГ" через один пробел: фиксированное
+//   число проверок, без циклов и без проверок выхода за границу буфера;
+// - общий путь (чтение чисел FastInput) для всего остального: несколько пробелов,
+//   переводы строк, другой длины год, конец куска при чтении через read.
+// Каждая дата проверяется: месяц 1..12, день не больше числа дней в месяце.
+// Двоичный и сжатый вход FastInput узнаёт сам и отдаёт числа без разбора
+// (запросов-символов в таком входе нет).
+#include <stdint.h>
+
+#include "fast_input.h"
+#include "calendar.h"
+
+class DateParser {
+	FastInput &in;
+	bool bad; // Встретилась некорректная запись
+
+	static inline bool IsDigit(char c) { return (unsigned)(c - '0') < 10; }
+
+	// Быстрый путь: "Д[Д] М[М] ГГГГ" с одиночными пробелами, следом не цифра.
+	// В буфере должно оставаться не меньше 11 байт - тогда границы проверять не нужно.
+	bool ParseFixed(int &d, int &m, int &y) {
+		const char *q = in.Position();
+		if (in.BufferEnd() - q < 11 || !IsDigit(q[0])) {
+			return false;
+		}
+		// Одна или две цифры дня: выбор через условную пересылку, без перехода
+		int two = IsDigit(q[1]);
+		d = two ? (q[0] - '0') * 10 + (q[1] - '0') : q[0] - '0';
+		q += 1 + two;
+		if (*q != ' ' || !IsDigit(q[1])) {
+			return false;
+		}
+		q++;
+		two = IsDigit(q[1]);
+		m = two ? (q[0] - '0') * 10 + (q[1] - '0') : q[0] - '0';
+		q += 1 + two;
+		if (*q != ' ') {
+			return false;
+		}
+		q++;
+		if (!IsDigit(q[0]) || !IsDigit(q[1]) || !IsDigit(q[2]) || !IsDigit(q[3]) || IsDigit(q[4])) {
+			return false;
+		}
+		y = (q[0] - '0') * 1000 + (q[1] - '0') * 100 + (q[2] - '0') * 10 + (q[3] - '0');
+		in.Skip(q + 4);
+		return true;
+	}
+
+public:
+	explicit DateParser(FastInput &input) : in(input), bad(false) {}
+
+	// Было ли что-то некорректное во входе (с последнего ClearBad)
+	bool Bad() const { return bad; }
+	void ClearBad() { bad = false; }
+
+	// Прочитать следующий непробельный символ (например, код команды)
+	bool NextChar(char &c) {
+		return in.Read(c);
+	}
+
+	// Пропустить остаток строки
+	void SkipLine() {
+		in.SkipLine();
+	}
+
+	// Прочитать целое число (например, количество записей)
+	bool NextInt(int &x) {
+		if (in.Eof()) {
+			return false;
+		}
+		if (!in.Read(x)) {
+			bad = true;
+			return false;
+		}
+		return true;
+	}
+
+	// Прочитать дату. Возвращает false в конце входа или при некорректной дате (тогда Bad()).
+	bool NextDate(int &d, int &m, int &y) {
+		// Eof пропускает пробелы - быстрый путь начинается прямо с цифры
+		if (in.Eof()) {
+			return false;
+		}
+		if (in.Binary() || !ParseFixed(d, m, y)) {
+			if (!in.Read(d) || !in.Read(m) || !in.Read(y)) {
+				bad = true;
+				return false;
+			}
+		}
+		if (m < 1 || m > 12 || d < 1 || d > DaysInMonth(m, y)) {
+			bad = true;
+			return false;
+		}
+		return true;
+	}
+
+	// Дата в формате d + m * 100 + y * 10000
+	bool NextPackedDate(int &date) {
+		int d, m, y;
+		if (!NextDate(d, m, y)) {
+			return false;
+		}
+		date = d + m * 100 + y * 10000;
+		return true;
+	}
+
+	// Номер дня даты (см. calendar.cpp)
+	bool NextDayOrdinal(int &day) {
+		int d, m, y;
+		if (!NextDate(d, m, y)) {
+			return false;
+		}
+		day = DayOrdinal(d, m, y);
+		return true;
+	}
+
+	// Запись из двух дат "д м г д м г" - упакованная пара (первая << 32) + вторая.
+	// ordinals - упаковать номера дней, иначе даты в формате d + m * 100 + y * 10000.
+	// Вторая дата читается, даже если первая некорректна, - чтобы после SkipLine
+	// (а в двоичном входе - сразу) следующая запись читалась с начала.
+	bool NextDatePair(int64_t &pair, bool ordinals = false) {
+		int a, b;
+		bool okA = ordinals ? NextDayOrdinal(a) : NextPackedDate(a);
+		bool okB = ordinals ? NextDayOrdinal(b) : NextPackedDate(b);
+		if (!okA || !okB) {
+			return false;
+		}
+		pair = ((int64_t)a << 32) + (uint32_t)b;
+		return true;
+	}
+};
@@ -0,0 +1,6 @@
+#ifndef DATE_PARSER_INCLUDED
+#define DATE_PARSER_INCLUDED
+
+#include "date_parser.cpp"
+
+#endif
@@ -0,0 +1,160 @@
+// Внешняя сортировка - для входных данных, не помещающихся в оперативную память
+// 1) Читаем вход кусками по budget байт, сортируем каждый кусок быстрейшей сортировкой
+//    в памяти и сбрасываем во временный файл в двоичном виде (как есть, без перевода в текст).
+// 2) Сливаем все куски (серии) деревом проигравших и отдаём элементы по одному в writer.
+//    Каждая серия читается блоками с двойной буферизацией: пока слияние разбирает один
+//    блок, следующий блок читается с диска асинхронно.
+// Память: на первом этапе - budget байт, на втором - 2 блока на серию, в сумме тоже budget.
+// http://en.wikipedia.org/wiki/External_sorting
+#include <vector>
+#include <future>
+#include <stdio.h>
+
+#include "loser_tree.h"
+
+// Читает серию из временного файла блоками по block элементов.
+// Пока отдаём элементы из cur, следующий блок читается в next в другом потоке.
+template<typename T>
+class RunReader {
+	FILE *f;
+	size_t block;
+	std::vector<T> cur; // Разбираемый блок
+	std::vector<T> next; // Читаемый заранее блок
+	size_t pos; // Позиция в cur
+	std::future<void> pending; // Асинхронное чтение next
+	bool failed; // Ошибка чтения - серия оборвалась раньше конца
+
+	void StartRead() {
+		pending = std::async(std::launch::async, [this]() {
+			next.resize(block);
+			size_t r = fread(&next[0], sizeof(T), block, f);
+			next.resize(r);
+			if (r < block && ferror(f)) {
+				failed = true;
+			}
+		});
+	}
+
+public:
+	RunReader(FILE *file, size_t blockSize) : f(file), block(blockSize), pos(0), failed(false) {
+		rewind(f);
+		StartRead();
+	}
+
+	~RunReader() {
+		if (pending.valid()) {
+			pending.wait();
+		}
+		fclose(f); // Временный файл удаляется автоматически
+	}
+
+	// Следующий элемент серии. Возвращает false, если серия кончилась.
+	bool Next(T &x) {
+		if (pos >= cur.size()) {
+			// Блок разобран - ждём прочитанный заранее и сразу заказываем следующий
+			pending.get();
+			cur.swap(next);
+			pos = 0;
+			if (cur.empty()) {
+				return false;
+			}
+			StartRead();
+		}
+		x = cur[pos++];
+		return true;
+	}
+
+	// Была ли ошибка чтения (проверять после того, как Next вернул false)
+	bool Failed() const {
+		return failed;
+	}
+};
+
+// Закрыть (и тем самым удалить) временные файлы серий
+inline void CloseRuns(std::vector<FILE *> &runs) {
+	for (size_t i = 0; i < runs.size(); i++) {
+		fclose(runs[i]);
+	}
+	runs.clear();
+}
+
+// Отсортировать поток элементов с ограничением памяти budget байт.
+// reader(x) - читает очередной элемент, возвращает false в конце ввода.
+// writer(x) - выводит очередной элемент результата.
+// sortRun(v) - сортировка серии в памяти.
+// Возвращает false при ошибке временных файлов (сообщение - в stderr); вывод тогда неполный.
+template<typename T, typename Reader, typename Writer, typename SortFn>
+bool ExternalSort(Reader reader, Writer writer, size_t budget, SortFn sortRun) {
+	size_t runSize = budget / sizeof(T);
+	if (runSize < 1) {
+		runSize = 1;
+	}
+
+	// Этап 1 - серии
+	std::vector<FILE *> runs;
+	std::vector<T> v;
+	v.reserve(runSize);
+	bool eof = false;
+	while (!eof) {
+		v.clear();
+		T x;
+		while (v.size() < runSize && !(eof = !reader(x))) {
+			v.push_back(x);
+		}
+		if (v.empty()) {
+			break;
+		}
+		sortRun(v);
+
+		// Всё поместилось в память с первого раза - файлы не нужны
+		if (eof && runs.empty()) {
+			for (size_t i = 0; i < v.size(); i++) {
+				writer(v[i]);
+			}
+			return true;
+		}
+
+		FILE *f = tmpfile();
+		if (f == NULL || fwrite(&v[0], sizeof(T), v.size(), f) != v.size() || fflush(f) != 0) {
+			perror("external sort: temp file");
+			if (f != NULL) {
+				fclose(f);
+			}
+			CloseRuns(runs);
+			return false;
+		}
+		runs.push_back(f);
+	}
+	// Память первого этапа больше не нужна
+	std::vector<T>().swap(v);
+
+	// Этап 2 - k-путевое слияние
+	int k = (int)runs.size();
+	size_t block = budget / (2 * k * sizeof(T));
+	if (block < 1) {
+		block = 1;
+	}
+	std::vector<RunReader<T> *> readers(k);
+	for (int r = 0; r < k; r++) {
+		readers[r] = new RunReader<T>(runs[r], block);
+	}
+
+	auto next = [&readers](int r, T &x) { return readers[r]->Next(x); };
+	LoserTree<T, decltype(next)> tree(k, next);
+	T x;
+	while (tree.Pop(x)) {
+		writer(x);
+	}
+
+	bool ok = true;
+	for (int r = 0; r < k; r++) {
+		if (readers[r]->Failed()) {
+			ok = false;
+		}
+		delete readers[r];
+	}
+	if (!ok) {
+		fprintf(stderr, "external sort: temp file read error\n");
+	}
+	return ok;
+}
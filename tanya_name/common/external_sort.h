@@ -0,0 +1,6 @@
+#ifndef EXTERNAL_SORT_INCLUDED
+#define EXTERNAL_SORT_INCLUDED
+
+#include "external_sort.cpp"
+
+#endif
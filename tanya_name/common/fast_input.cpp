@@ -0,0 +1,293 @@
+// Быстрое чтение входа для всех программ
+// std::cin >> x на каждое число в разы медленнее самих алгоритмов: проверки потока,
+// локаль, разбор через общие функции. Здесь вход разбирается по указателю в буфере:
+// - обычный файл (в том числе stdin после freopen) отображается в память через mmap;
+// - иначе (канал, терминал, интерактивная программа) читается кусками через read по мере
+//   надобности - следующий кусок запрашивается, только когда текущий кончился, поэтому
+//   программы, которые отвечают на каждую строку входа (codingame), не зависают.
+// Разборщики: целые int32/int64 (со знаком), слова до пробела, одиночные символы,
+// записи "+ слово" (команда и слово) и "ключ k" (два числа), массивы чисел -
+// заданного размера (память выделяется сразу под весь размер) или до конца входа.
+// Каждое чтение возвращает false, если вход кончился или на месте числа не число.
+// Отображённый файл в двоичном формате (common/binary_array.cpp) узнаётся по заголовку:
+// числа берутся из него как есть, массивы копируются целиком, без разбора.
+// Так же узнаётся сжатый отсортированный файл (common/packed_array.cpp) - он распаковывается
+// по блоку по мере чтения.
+#include <vector>
+#include <string>
+#include <utility>
+#include <type_traits>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "binary_array.h"
+#include "packed_array.h"
+
+// Размер куска для чтения через read
+#define FAST_INPUT_BUFFER (64 * 1024)
+
+class FastInput {
+	int fd;
+	const char *p; // Текущая позиция
+	const char *end; // Конец прочитанного
+	const char *map; // Отображённый файл (NULL - читаем через read)
+	size_t mapSize;
+	std::vector<char> buf;
+	// Двоичный файл: тип элементов (0 - текст), сами элементы, их число и позиция
+	int binType;
+	const char *bin;
+	uint64_t binCount;
+	uint64_t binPos;
+	bool binSorted;
+	// Сжатый файл и его распакованный блок, в котором находится binPos
+	bool isPacked;
+	PackedArray packed;
+	int64_t block[PACKED_BLOCK];
+
+	// Дочитать следующий кусок. false - вход кончился.
+	bool Refill() {
+		if (map) {
+			return false;
+		}
+		ssize_t r = read(fd, &buf[0], buf.size());
+		p = &buf[0];
+		end = p + (r > 0 ? r : 0);
+		return r > 0;
+	}
+
+	// Текущий символ, -1 - конец входа
+	inline int Peek() {
+		if (p == end && !Refill()) {
+			return -1;
+		}
+		return (unsigned char)*p;
+	}
+
+	// Пропустить пробелы и переводы строк. false - дальше только конец входа.
+	inline bool SkipSpaces() {
+		int c;
+		while ((c = Peek()) >= 0 && c <= ' ') {
+			p++;
+		}
+		return c >= 0;
+	}
+
+	// Целое со знаком (необязательный минус). Переполнение не проверяется.
+	template<typename T>
+	bool ReadInteger(T &x) {
+		if (binType) {
+			if (binPos == binCount) {
+				return false;
+			}
+			if (isPacked) {
+				size_t i = (size_t)(binPos % PACKED_BLOCK);
+				if (i == 0) {
+					packed.DecodeBlock((size_t)(binPos / PACKED_BLOCK), block);
+				}
+				x = (T)block[i];
+			} else {
+				x = (T)LoadBinary(bin + binPos * BinaryElementSize(binType), binType);
+			}
+			binPos++;
+			return true;
+		}
+		if (!SkipSpaces()) {
+			return false;
+		}
+		bool neg = (*p == '-');
+		if (neg) {
+			p++;
+		}
+		int c = Peek();
+		if (c < '0' || c > '9') {
+			return false;
+		}
+		typedef typename std::make_unsigned<T>::type U;
+		U r = 0;
+		do {
+			r = r * 10 + (U)(c - '0');
+			p++;
+		} while ((c = Peek()) >= '0' && c <= '9');
+		x = neg ? (T)(0 - r) : (T)r;
+		return true;
+	}
+
+	// До n элементов двоичного файла в конец v: копирование куска, если тип совпадает.
+	// Из сжатого файла целые блоки распаковываются сразу на место.
+	template<typename T>
+	size_t ReadBinary(std::vector<T> &v, size_t n) {
+		size_t elem = BinaryElementSize(binType);
+		size_t k = n < binCount - binPos ? n : (size_t)(binCount - binPos);
+		size_t old = v.size();
+		v.resize(old + k);
+		if (isPacked) {
+			for (size_t i = 0; i < k; ) {
+				if (binPos % PACKED_BLOCK == 0 && k - i >= PACKED_BLOCK) {
+					packed.DecodeBlock((size_t)(binPos / PACKED_BLOCK), &v[old + i]);
+					binPos += PACKED_BLOCK;
+					i += PACKED_BLOCK;
+				} else {
+					ReadInteger(v[old + i]);
+					i++;
+				}
+			}
+			return k;
+		}
+		const char *src = bin + binPos * elem;
+		if (BINARY_HOST_LITTLE_ENDIAN && sizeof(T) == elem) {
+			memcpy(&v[old], src, k * elem);
+		} else {
+			for (size_t i = 0; i < k; i++) {
+				v[old + i] = (T)LoadBinary(src + i * elem, binType);
+			}
+		}
+		binPos += k;
+		return k;
+	}
+
+public:
+	// fd - дескриптор входа, по умолчанию stdin
+	explicit FastInput(int fd = 0) : fd(fd), p(NULL), end(NULL), map(NULL), mapSize(0),
+			binType(0), bin(NULL), binCount(0), binPos(0), binSorted(false), isPacked(false) {
+		struct stat st;
+		if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+			// Читаем с текущей позиции файла (её мог сдвинуть кто-то до нас)
+			off_t pos = lseek(fd, 0, SEEK_CUR);
+			void *m = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (m != MAP_FAILED) {
+				madvise(m, st.st_size, MADV_SEQUENTIAL);
+				map = (const char *)m;
+				mapSize = st.st_size;
+				p = map + (pos > 0 && pos <= st.st_size ? pos : 0);
+				end = map + mapSize;
+				BinaryHeader h;
+				if (ParseBinaryHeader(p, end - p, h)) {
+					binType = h.type;
+					bin = p + sizeof(BinaryHeader);
+					binCount = h.count;
+					binSorted = h.sorted != 0;
+				} else if (packed.Open(p, end - p)) {
+					binType = packed.Type();
+					binCount = packed.Size();
+					binSorted = true;
+					isPacked = true;
+				}
+				return;
+			}
+		}
+		buf.resize(FAST_INPUT_BUFFER);
+		p = end = &buf[0];
+	}
+
+	~FastInput() {
+		if (map) {
+			munmap((void *)map, mapSize);
+		}
+	}
+
+	// Остались ли во входе непробельные символы
+	bool Eof() { return binType ? binPos == binCount : !SkipSpaces(); }
+
+	// Вход - двоичный файл, в котором вся последовательность помечена неубывающей,
+	// или сжатый (он всегда упорядочен)
+	bool Sorted() const { return binType && binSorted; }
+
+	bool Read(int32_t &x) { return ReadInteger(x); }
+	bool Read(int64_t &x) { return ReadInteger(x); }
+
+	// Слово до ближайшего пробела или перевода строки
+	bool Read(std::string &s) {
+		s.clear();
+		if (binType || !SkipSpaces()) {
+			return false;
+		}
+		while (Peek() > ' ') {
+			const char *q = p;
+			while (q < end && (unsigned char)*q > ' ') {
+				q++;
+			}
+			s.append(p, q);
+			p = q;
+		}
+		return true;
+	}
+
+	// Пропустить остаток строки (до перевода строки)
+	void SkipLine() {
+		int c;
+		while ((c = Peek()) >= 0 && c != '\n') {
+			p++;
+		}
+	}
+
+	// Вход - двоичный или сжатый файл (в нём только числа)
+	bool Binary() const { return binType != 0; }
+
+	// Непрочитанная часть буфера [Position(), BufferEnd()) - для разборщиков поверх FastInput
+	// (common/date_parser.cpp). При чтении через read в ней только остаток текущего куска.
+	const char *Position() const { return p; }
+	const char *BufferEnd() const { return end; }
+	// Продвинуться до q внутри буфера
+	void Skip(const char *q) { p = q; }
+
+	// Один непробельный символ
+	bool Read(char &c) {
+		if (binType || !SkipSpaces()) {
+			return false;
+		}
+		c = *p++;
+		return true;
+	}
+
+	// Запись "+ слово": символ команды и слово
+	bool ReadCommand(char &op, std::string &word) {
+		return Read(op) && Read(word);
+	}
+
+	// Запись "ключ k": два числа
+	template<typename K, typename V>
+	bool ReadPair(K &key, V &value) {
+		return Read(key) && Read(value);
+	}
+
+	// Дописать в v до n чисел или слов (память под n выделяется сразу).
+	// Возвращает число прочитанных.
+	template<typename T>
+	size_t Read(std::vector<T> &v, size_t n) {
+		if constexpr (std::is_integral<T>::value) {
+			if (binType) {
+				return ReadBinary(v, n);
+			}
+		}
+		v.reserve(v.size() + n);
+		size_t read = 0;
+		T x;
+		while (read < n && Read(x)) {
+			v.push_back(std::move(x));
+			read++;
+		}
+		return read;
+	}
+
+	// Дописать в v все числа (или слова) до конца входа. Возвращает число прочитанных.
+	template<typename T>
+	size_t ReadAll(std::vector<T> &v) {
+		if (binType) {
+			return Read(v, (size_t)(binCount - binPos));
+		}
+		size_t read = 0;
+		T x;
+		while (Read(x)) {
+			v.push_back(std::move(x));
+			read++;
+		}
+		return read;
+	}
+
+private:
+	// Копировать нельзя - двойной munmap
+	FastInput(const FastInput &);
+	FastInput &operator=(const FastInput &);
+};
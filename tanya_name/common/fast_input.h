@@ -0,0 +1,6 @@
+#ifndef FAST_INPUT_INCLUDED
+#define FAST_INPUT_INCLUDED
+
+#include "fast_input.cpp"
+
+#endif
@@ -0,0 +1,190 @@
+// Очередь с приоритетами на двоичной куче (как в heap_sort.cpp: родитель не меньше детей)
+// HeapQueue - обычная очередь: построение кучи из n элементов за O(n), вставка и извлечение
+// максимума за O(log n), пакетная вставка.
+// IndexedHeapQueue - очередь элементов с номерами 0..n-1, у которой можно менять приоритет
+// элемента по номеру (decrease-key / increase-key) - позиция каждого номера в куче хранится
+// в отдельном массиве. Нужна для планировщиков, алгоритма Дейкстры и т.п.
+//
+// Просейки общие с пирамидальной сортировкой - см. heap_sift.cpp.
+#include <vector>
+#include <functional>
+#include <utility>
+
+#include "heap_sift.h"
+
+template<typename T, typename Less = std::less<T> >
+class HeapQueue {
+	std::vector<T> h;
+	Less less;
+
+	// Восстановить свойство кучи во всём массиве за O(n)
+	void Heapify() {
+		for (size_t i = h.size() / 2; i-- > 0;) {
+			SiftDown(h.data(), i, h.size(), less);
+		}
+	}
+
+public:
+	explicit HeapQueue(const Less &cmp = Less()) : less(cmp) {}
+
+	// Построить очередь сразу из всех элементов за O(n)
+	explicit HeapQueue(std::vector<T> items, const Less &cmp = Less()) : h(std::move(items)), less(cmp) {
+		Heapify();
+	}
+
+	bool empty() const { return h.empty(); }
+	size_t size() const { return h.size(); }
+	void reserve(size_t n) { h.reserve(n); }
+
+	// Максимальный элемент
+	const T &top() const { return h[0]; }
+
+	void push(const T &x) {
+		h.push_back(x);
+		SiftUp(h.data(), h.size() - 1, 0, less);
+	}
+
+	void push(T &&x) {
+		h.push_back(std::move(x));
+		SiftUp(h.data(), h.size() - 1, 0, less);
+	}
+
+	// Пакетная вставка. Если добавляется много элементов по сравнению с размером очереди,
+	// выгоднее дописать их все и перестроить кучу целиком за O(n + k),
+	// чем вставлять по одному за O(k log(n + k)).
+	void push_batch(std::vector<T> items) {
+		size_t old = h.size();
+		h.reserve(old + items.size());
+		for (size_t i = 0; i < items.size(); i++) {
+			h.push_back(std::move(items[i]));
+		}
+		if (items.size() > old / 2) {
+			Heapify();
+		} else {
+			for (size_t i = old; i < h.size(); i++) {
+				SiftUp(h.data(), i, 0, less);
+			}
+		}
+	}
+
+	// Извлечь максимальный элемент
+	T pop() {
+		T r = std::move(h[0]);
+		T last = std::move(h.back());
+		h.pop_back();
+		if (!h.empty()) {
+			SiftDownBottomUp(h.data(), 0, h.size(), std::move(last), less);
+		}
+		return r;
+	}
+};
+
+
+// Очередь элементов с номерами 0..capacity-1 и изменяемыми приоритетами.
+// В куче хранятся только номера (переставлять int дёшево), приоритеты лежат по номерам.
+template<typename T, typename Less = std::less<T> >
+class IndexedHeapQueue {
+	std::vector<int> h; // Куча номеров
+	std::vector<int> pos; // Позиция номера в куче, -1 - номера нет в очереди
+	std::vector<T> keys; // Приоритет по номеру
+	Less less;
+
+	static inline int left(int i) { return (i * 2) + 1; }
+	static inline int parent(int i) { return (i - 1) / 2; }
+
+	inline bool Before(int a, int b) const { return less(keys[a], keys[b]); }
+
+	void SiftUp(int p) {
+		int id = h[p];
+		while (p > 0 && Before(h[parent(p)], id)) {
+			h[p] = h[parent(p)];
+			pos[h[p]] = p;
+			p = parent(p);
+		}
+		h[p] = id;
+		pos[id] = p;
+	}
+
+	void SiftDown(int p) {
+		int n = (int)h.size();
+		int id = h[p];
+		while (true) {
+			int c = left(p);
+			if (c >= n) {
+				break;
+			}
+			if (c + 1 < n && Before(h[c], h[c + 1])) {
+				c++;
+			}
+			if (!Before(id, h[c])) {
+				break;
+			}
+			h[p] = h[c];
+			pos[h[p]] = p;
+			p = c;
+		}
+		h[p] = id;
+		pos[id] = p;
+	}
+
+public:
+	explicit IndexedHeapQueue(int capacity, const Less &cmp = Less())
+			: pos(capacity, -1), keys(capacity), less(cmp) {}
+
+	bool empty() const { return h.empty(); }
+	size_t size() const { return h.size(); }
+	bool contains(int id) const { return pos[id] >= 0; }
+	const T &key(int id) const { return keys[id]; }
+
+	// Номер элемента с максимальным приоритетом
+	int top() const { return h[0]; }
+
+	// Добавить номер id с приоритетом key (если уже есть - изменить приоритет)
+	void push(int id, T key) {
+		if (contains(id)) {
+			update(id, std::move(key));
+			return;
+		}
+		keys[id] = std::move(key);
+		h.push_back(id);
+		SiftUp((int)h.size() - 1);
+	}
+
+	// Изменить приоритет номера id (в любую сторону)
+	void update(int id, T key) {
+		bool up = less(keys[id], key);
+		keys[id] = std::move(key);
+		if (up) {
+			SiftUp(pos[id]);
+		} else {
+			SiftDown(pos[id]);
+		}
+	}
+
+	// Извлечь номер с максимальным приоритетом
+	int pop() {
+		int id = h[0];
+		pos[id] = -1;
+		int last = h.back();
+		h.pop_back();
+		if (!h.empty()) {
+			h[0] = last;
+			SiftDown(0);
+		}
+		return id;
+	}
+
+	// Убрать номер id из очереди
+	void erase(int id) {
+		int p = pos[id];
+		pos[id] = -1;
+		int last = h.back();
+		h.pop_back();
+		if (last != id) {
+			h[p] = last;
+			pos[last] = p;
+			SiftUp(p);
+			SiftDown(pos[last]);
+		}
+	}
+};
@@ -0,0 +1,6 @@
+#ifndef HEAP_QUEUE_INCLUDED
+#define HEAP_QUEUE_INCLUDED
+
+#include "heap_queue.cpp"
+
+#endif
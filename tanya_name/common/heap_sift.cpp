@@ -0,0 +1,88 @@
+// Просейки двоичной кучи (родитель не меньше детей) на массиве h[0..n)
+// Общие для пирамидальной сортировки (sort_2/heap_sort.cpp) и очереди с приоритетами
+// (common/heap_queue.cpp).
+//
+// Просейка "с дыркой": элемент не меняется местами на каждом уровне (3 присваивания),
+// а достаётся один раз, на его место сдвигаются дети/родители, и в конце он ставится в дырку
+// (1 присваивание на уровень). Элементы только перемещаются (std::move), поэтому подходят
+// и типы без копирования (std::unique_ptr и т.п.).
+#include <stddef.h>
+#include <utility>
+
+inline size_t HeapLeft(size_t i) { return (i * 2) + 1; }
+inline size_t HeapParent(size_t i) { return (i - 1) / 2; }
+
+// Поднять h[p], но не выше вершины top (при построении кучи выше top - ещё не куча)
+template<typename T, typename Less>
+inline void SiftUp(T *h, size_t p, size_t top, Less less) {
+	T x = std::move(h[p]);
+	while (p > top && less(h[HeapParent(p)], x)) {
+		h[p] = std::move(h[HeapParent(p)]);
+		p = HeapParent(p);
+	}
+	h[p] = std::move(x);
+}
+
+// Опустить h[p] в куче из n элементов
+template<typename T, typename Less>
+inline void SiftDown(T *h, size_t p, size_t n, Less less) {
+	T x = std::move(h[p]);
+	while (true) {
+		size_t c = HeapLeft(p);
+		if (c >= n) {
+			break;
+		}
+		// Больший из детей
+		if (c + 1 < n && less(h[c], h[c + 1])) {
+			c++;
+		}
+		if (!less(x, h[c])) {
+			break;
+		}
+		h[p] = std::move(h[c]);
+		p = c;
+	}
+	h[p] = std::move(x);
+}
+
+// Восходящая (bottom-up) просейка: поставить x в дырку p, спустив дырку до листа по большим
+// детям (одно сравнение на уровень - детей между собой), а затем подняв x от листа не выше p.
+// Место x почти всегда у самого низа (обычно x - бывший последний, маленький элемент кучи),
+// поэтому в сумме около n log n сравнений вместо 2 n log n.
+// Алгоритм: http://en.wikipedia.org/wiki/Heapsort#Bottom-up_heapsort
+template<typename T, typename Less>
+inline void SiftDownBottomUp(T *h, size_t p, size_t n, T x, Less less) {
+	size_t top = p;
+	size_t c;
+	while ((c = HeapLeft(p)) + 1 < n) {
+		// Выбор ребёнка без перехода не даёт процессору заранее загрузить следующий
+		// уровень - подгружаем внуков детей сами (на больших кучах это промахи кэша)
+		size_t cc = HeapLeft(HeapLeft(c));
+		if (cc < n) {
+			__builtin_prefetch(&h[cc]);
+		}
+		c += less(h[c], h[c + 1]);
+		h[p] = std::move(h[c]);
+		p = c;
+	}
+	if (c < n) {
+		h[p] = std::move(h[c]);
+		p = c;
+	}
+	h[p] = std::move(x);
+	SiftUp(h, p, top, less);
+}
+
+// Пирамидальная сортировка h[0..n): построение кучи за O(n), затем n извлечений
+// максимума восходящей просейкой. Всегда O(n log n) - запасной путь быстрой сортировки.
+template<typename T, typename Less>
+inline void HeapSort(T *h, size_t n, Less less) {
+	for (size_t i = n / 2; i-- > 0;) {
+		SiftDown(h, i, n, less);
+	}
+	for (size_t i = n; i-- > 1;) {
+		T x = std::move(h[i]);
+		h[i] = std::move(h[0]);
+		SiftDownBottomUp(h, 0, i, std::move(x), less);
+	}
+}
@@ -0,0 +1,6 @@
+#ifndef HEAP_SIFT_INCLUDED
+#define HEAP_SIFT_INCLUDED
+
+#include "heap_sift.cpp"
+
+#endif
@@ -0,0 +1,99 @@
+// Дерево проигравших (турнирное дерево) для k-путевого слияния отсортированных потоков
+// В листьях - текущие элементы k потоков, во внутренних вершинах - номер потока,
+// проигравшего в "матче" в этой вершине, в tree[0] - общий победитель (минимум).
+// После выдачи минимума в его лист приходит следующий элемент того же потока, и он
+// проходит путь от листа к корню, играя только с проигравшими на этом пути:
+// ровно ceil(log2 k) сравнений на элемент (у кучи - до 2 log2 k), памяти - только 2k ячеек,
+// при работе ничего не выделяется.
+// Алгоритм: Кнут, "Искусство программирования", т. 3, 5.4.1
+// http://en.wikipedia.org/wiki/K-way_merge_algorithm#Tournament_Tree
+#include <vector>
+#include <stddef.h>
+
+// next(i, x) - прочитать следующий элемент потока i в x, вернуть false, если поток кончился
+template<typename T, typename Source>
+class LoserTree {
+	int k; // Количество потоков
+	Source next;
+	std::vector<T> keys; // Текущий элемент каждого потока
+	std::vector<bool> done; // Поток кончился - считаем его элемент бесконечностью
+	std::vector<int> tree; // tree[0] - победитель, tree[1..k-1] - проигравшие во внутренних вершинах
+
+	// Поток a выигрывает у потока b. При равенстве выигрывает меньший номер - слияние устойчиво.
+	inline bool Wins(int a, int b) const {
+		if (done[a] || done[b]) {
+			return !done[a];
+		}
+		return keys[a] < keys[b] || (!(keys[b] < keys[a]) && a < b);
+	}
+
+public:
+	LoserTree(int streams, Source source)
+			: k(streams), next(source), keys(streams), done(streams), tree(streams > 1 ? streams : 1) {
+		for (int i = 0; i < k; i++) {
+			done[i] = !next(i, keys[i]);
+		}
+
+		// Строим дерево снизу вверх. Лист потока i - вершина k + i, дети вершины p - 2p и 2p + 1.
+		std::vector<int> winner(2 * k);
+		for (int i = 0; i < k; i++) {
+			winner[k + i] = i;
+		}
+		for (int p = k - 1; p >= 1; p--) {
+			int a = winner[2 * p];
+			int b = winner[2 * p + 1];
+			if (Wins(a, b)) {
+				winner[p] = a;
+				tree[p] = b;
+			} else {
+				winner[p] = b;
+				tree[p] = a;
+			}
+		}
+		tree[0] = (k > 1) ? winner[1] : 0;
+	}
+
+	// Выдать минимальный элемент всех потоков. Возвращает false, если все потоки кончились.
+	bool Pop(T &x) {
+		if (k == 0) {
+			return false;
+		}
+		int w = tree[0];
+		if (done[w]) {
+			return false;
+		}
+		x = keys[w];
+
+		// Следующий элемент того же потока поднимается от листа к корню
+		done[w] = !next(w, keys[w]);
+		for (int p = (k + w) / 2; p > 0; p /= 2) {
+			if (Wins(tree[p], w)) {
+				int temp = tree[p];
+				tree[p] = w;
+				w = temp;
+			}
+		}
+		tree[0] = w;
+		return true;
+	}
+};
+
+// Слить отсортированные серии runs в out, не больше limit элементов
+template<typename T>
+void MergeRuns(const std::vector<std::vector<T> > &runs, size_t limit, std::vector<T> &out) {
+	std::vector<size_t> pos(runs.size());
+	auto next = [&runs, &pos](int i, T &x) {
+		if (pos[i] >= runs[i].size()) {
+			return false;
+		}
+		x = runs[i][pos[i]++];
+		return true;
+	};
+	LoserTree<T, decltype(next)> tree((int)runs.size(), next);
+
+	out.clear();
+	T x;
+	while (out.size() < limit && tree.Pop(x)) {
+		out.push_back(x);
+	}
+}
@@ -0,0 +1,6 @@
+#ifndef LOSER_TREE_INCLUDED
+#define LOSER_TREE_INCLUDED
+
+#include "loser_tree.cpp"
+
+#endif
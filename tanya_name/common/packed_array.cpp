@@ -0,0 +1,430 @@
+// Сжатый формат отсортированной последовательности целых: разности + упаковка битов
+// Отсортированный вывод в тексте занимает ~10 байт на число, в двоичном виде 4-8 байт,
+// хотя соседние числа отличаются мало. Здесь последовательность режется на блоки
+// по PACKED_BLOCK чисел, в блоке хранятся разности соседних чисел, каждая ровно в b бит,
+// где b - число бит наибольшей разности в блоке (для 10^7 чисел до 10^9 это ~8 бит).
+// Биты упаковываются "вертикально" в 4 полосы: число i блока идёт в полосу i % 4, и каждая
+// полоса упаковывается в свои 32-битные слова. Так упаковка и распаковка - одни и те же
+// сдвиги и маски сразу над 4 числами в регистре SSE2, для каждого b своя развёрнутая
+// функция без циклов и переходов.
+// Алгоритм: Lemire, Boytsov - Decoding billions of integers per second through vectorization
+// (SIMD-BP128, FastPFor) http://arxiv.org/abs/1209.2137
+//
+// Файл:
+//   заголовок, 24 байта: "TNPK", тип элементов (BINARY_INT32 / BINARY_INT64),
+//   3 байта резерва, число элементов (uint64), смещение индекса (uint64);
+//   блоки: 16 * b байт упакованных разностей (первая разность блока - 0) или, если разность
+//   не помещается в 32 бита, 1024 байта разностей как uint64 (считается b = 64);
+//   индекс: для каждого блока первое число (int64) и смещение блока в файле (uint64).
+// b блока - размер блока / 16, поэтому его отдельно не храним. По индексу любой блок
+// распаковывается независимо: доступ к i-му числу и поиск - без распаковки всего файла.
+// Всё little-endian.
+#include <vector>
+#include <utility>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#include "binary_array.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Чисел в блоке
+#define PACKED_BLOCK 128
+#define PACKED_MAGIC "TNPK"
+// "Ширина" блока с разностями без упаковки (uint64)
+#define PACKED_RAW_BITS 64
+
+struct PackedHeader {
+	char magic[4];
+	uint8_t type;
+	uint8_t reserved[3];
+	uint64_t count;
+	uint64_t indexOffset;
+};
+
+static_assert(sizeof(PackedHeader) == 24, "заголовок сжатого файла - 24 байта");
+
+struct PackedIndex {
+	int64_t first; // Первое число блока
+	uint64_t offset; // Смещение блока от начала файла
+};
+
+// Упаковать 128 чисел по B бит (все числа < 2^B) в 4 * B слов.
+// Строка r - числа 4r..4r+3, по одному на полосу; полоса копит биты в своём слове.
+template<int B>
+void PackBlock(const uint32_t *in, uint32_t *out) {
+	if constexpr (B > 0) {
+#ifdef __SSE2__
+		__m128i acc = _mm_setzero_si128();
+		int shift = 0;
+#pragma GCC unroll 32
+		for (int r = 0; r < PACKED_BLOCK / 4; r++) {
+			__m128i v = _mm_loadu_si128((const __m128i *)(in + 4 * r));
+			acc = _mm_or_si128(acc, _mm_slli_epi32(v, shift));
+			shift += B;
+			if (shift >= 32) {
+				_mm_storeu_si128((__m128i *)out, acc);
+				out += 4;
+				shift -= 32;
+				// Старшие биты числа, не поместившиеся в слово, - в начало следующего
+				acc = shift > 0 ? _mm_srli_epi32(v, B - shift) : _mm_setzero_si128();
+			}
+		}
+#else
+		for (int lane = 0; lane < 4; lane++) {
+			uint64_t acc = 0;
+			int bits = 0;
+			uint32_t *o = out + lane;
+			for (int r = 0; r < PACKED_BLOCK / 4; r++) {
+				acc |= (uint64_t)in[4 * r + lane] << bits;
+				bits += B;
+				if (bits >= 32) {
+					*o = LittleEndian((uint32_t)acc);
+					o += 4;
+					acc >>= 32;
+					bits -= 32;
+				}
+			}
+		}
+#endif
+	}
+}
+
+// Распаковать 4 * B слов в 128 чисел (обратное к PackBlock)
+template<int B>
+void UnpackBlock(const uint32_t *in, uint32_t *out) {
+	if constexpr (B == 0) {
+		memset(out, 0, PACKED_BLOCK * sizeof(uint32_t));
+	} else {
+#ifdef __SSE2__
+		const __m128i mask = _mm_set1_epi32(B == 32 ? -1 : (int)((1u << B) - 1));
+		__m128i w = _mm_loadu_si128((const __m128i *)in);
+		in += 4;
+		int shift = 0;
+#pragma GCC unroll 32
+		for (int r = 0; r < PACKED_BLOCK / 4; r++) {
+			__m128i v = _mm_srli_epi32(w, shift);
+			shift += B;
+			if (shift > 32) {
+				// Число начинается в этом слове и кончается в следующем
+				w = _mm_loadu_si128((const __m128i *)in);
+				in += 4;
+				shift -= 32;
+				v = _mm_or_si128(v, _mm_slli_epi32(w, B - shift));
+			} else if (shift == 32 && r + 1 < PACKED_BLOCK / 4) {
+				w = _mm_loadu_si128((const __m128i *)in);
+				in += 4;
+				shift = 0;
+			}
+			_mm_storeu_si128((__m128i *)(out + 4 * r), _mm_and_si128(v, mask));
+		}
+#else
+		const uint64_t mask = B == 32 ? 0xFFFFFFFFull : (1ull << B) - 1;
+		for (int lane = 0; lane < 4; lane++) {
+			uint64_t acc = 0;
+			int bits = 0;
+			const uint32_t *w = in + lane;
+			for (int r = 0; r < PACKED_BLOCK / 4; r++) {
+				if (bits < B) {
+					acc |= (uint64_t)LittleEndian(*w) << bits;
+					w += 4;
+					bits += 32;
+				}
+				out[4 * r + lane] = (uint32_t)(acc & mask);
+				acc >>= B;
+				bits -= B;
+			}
+		}
+#endif
+	}
+}
+
+typedef void (*PackFn)(const uint32_t *in, uint32_t *out);
+
+// Таблицы функций для всех b = 0..32
+template<size_t... B>
+const PackFn *PackTable(std::index_sequence<B...>) {
+	static const PackFn table[] = {PackBlock<(int)B>...};
+	return table;
+}
+
+template<size_t... B>
+const PackFn *UnpackTable(std::index_sequence<B...>) {
+	static const PackFn table[] = {UnpackBlock<(int)B>...};
+	return table;
+}
+
+// Число бит, нужное для x
+inline int BitWidth(uint64_t x) {
+	return x == 0 ? 0 : 64 - __builtin_clzll(x);
+}
+
+// Сжать блок v[0..n) (0 < n <= PACKED_BLOCK, неубывающий) в out. Возвращает размер в байтах.
+// out - не меньше PACKED_BLOCK * 8 байт.
+inline size_t EncodePackedBlock(const int64_t *v, int n, char *out) {
+	uint64_t delta[PACKED_BLOCK];
+	uint64_t all = 0; // ИЛИ всех разностей - по нему ширина
+	delta[0] = 0;
+	for (int i = 1; i < n; i++) {
+		delta[i] = (uint64_t)v[i] - (uint64_t)v[i - 1];
+		all |= delta[i];
+	}
+	for (int i = n; i < PACKED_BLOCK; i++) {
+		delta[i] = 0;
+	}
+
+	int bits = BitWidth(all);
+	if (bits > 32) {
+		for (int i = 0; i < PACKED_BLOCK; i++) {
+			uint64_t le = LittleEndian(delta[i]);
+			memcpy(out + 8 * i, &le, 8);
+		}
+		return PACKED_BLOCK * 8;
+	}
+	uint32_t narrow[PACKED_BLOCK];
+	for (int i = 0; i < PACKED_BLOCK; i++) {
+		narrow[i] = (uint32_t)delta[i];
+	}
+	static const PackFn *pack = PackTable(std::make_index_sequence<33>());
+	uint32_t words[PACKED_BLOCK];
+	pack[bits](narrow, words);
+	memcpy(out, words, 16 * bits);
+	return 16 * bits;
+}
+
+// Последовательная запись сжатого файла по одному числу (как BinaryWriter):
+// заголовок переписывается в Close, f должен быть обычным файлом.
+class PackedWriter {
+	FILE *f;
+	int type;
+	long start; // Где в файле заголовок
+	uint64_t offset; // Смещение следующего блока от заголовка
+	uint64_t count;
+	int64_t last; // Последнее записанное число
+	int64_t block[PACKED_BLOCK];
+	int used; // Чисел в block
+	std::vector<PackedIndex> index;
+	bool ok;
+
+	bool FlushBlock() {
+		if (used == 0) {
+			return true;
+		}
+		char out[PACKED_BLOCK * 8];
+		size_t size = EncodePackedBlock(block, used, out);
+		PackedIndex e;
+		e.first = block[0];
+		e.offset = offset;
+		index.push_back(e);
+		offset += size;
+		used = 0;
+		return size == 0 || fwrite(out, 1, size, f) == size;
+	}
+
+	bool WriteHeader(uint64_t indexOffset) {
+		PackedHeader h;
+		memcpy(h.magic, PACKED_MAGIC, 4);
+		h.type = (uint8_t)type;
+		memset(h.reserved, 0, sizeof(h.reserved));
+		h.count = LittleEndian(count);
+		h.indexOffset = LittleEndian(indexOffset);
+		return fwrite(&h, sizeof(h), 1, f) == 1;
+	}
+
+public:
+	PackedWriter(FILE *file, int elementType)
+		: f(file), type(elementType), offset(sizeof(PackedHeader)), count(0), last(0), used(0), ok(true) {
+		start = ftell(f);
+		ok = WriteHeader(0);
+	}
+
+	// false - число меньше предыдущего, не помещается в тип элементов или ошибка записи
+	bool Write(int64_t x) {
+		if (!ok || (type == BINARY_INT32 && (x < INT32_MIN || x > INT32_MAX))
+				|| (count > 0 && x < last)) {
+			return false;
+		}
+		block[used++] = x;
+		last = x;
+		count++;
+		if (used == PACKED_BLOCK) {
+			ok = FlushBlock();
+		}
+		return ok;
+	}
+
+	uint64_t Count() const { return count; }
+
+	// Дописать последний блок, индекс и настоящий заголовок. false - ошибка записи.
+	bool Close() {
+		ok = ok && FlushBlock();
+		uint64_t indexOffset = offset;
+		for (size_t i = 0; ok && i < index.size(); i++) {
+			PackedIndex e;
+			e.first = (int64_t)LittleEndian((uint64_t)index[i].first);
+			e.offset = LittleEndian(index[i].offset);
+			ok = fwrite(&e, sizeof(e), 1, f) == 1;
+		}
+		ok = ok && fseek(f, start, SEEK_SET) == 0 && WriteHeader(indexOffset);
+		return ok && fseek(f, 0, SEEK_END) == 0 && fflush(f) == 0;
+	}
+};
+
+// Сжатый файл в памяти (например, отображённый через mmap): распаковка блоков,
+// i-е число и поиск по индексу
+class PackedArray {
+	const char *data;
+	PackedHeader header;
+	const char *index;
+	size_t blocks;
+
+	PackedIndex Entry(size_t b) const {
+		PackedIndex e;
+		memcpy(&e, index + b * sizeof(PackedIndex), sizeof(e));
+		e.first = (int64_t)LittleEndian((uint64_t)e.first);
+		e.offset = LittleEndian(e.offset);
+		return e;
+	}
+
+	uint64_t BlockEnd(size_t b) const {
+		return b + 1 < blocks ? Entry(b + 1).offset : header.indexOffset;
+	}
+
+public:
+	PackedArray() : data(NULL), index(NULL), blocks(0) {
+		memset(&header, 0, sizeof(header));
+	}
+
+	// Разобрать файл [p, p + size). false - это не сжатый файл или он повреждён.
+	bool Open(const char *p, size_t size) {
+		if (size < sizeof(PackedHeader)) {
+			return false;
+		}
+		PackedHeader h;
+		memcpy(&h, p, sizeof(h));
+		h.count = LittleEndian(h.count);
+		h.indexOffset = LittleEndian(h.indexOffset);
+		size_t n = (size_t)((h.count + PACKED_BLOCK - 1) / PACKED_BLOCK);
+		if (memcmp(h.magic, PACKED_MAGIC, 4) != 0 || BinaryElementSize(h.type) == 0
+				|| h.indexOffset < sizeof(PackedHeader) || h.indexOffset > size
+				|| (size - h.indexOffset) / sizeof(PackedIndex) < n) {
+			return false;
+		}
+		data = p;
+		header = h;
+		index = p + h.indexOffset;
+		blocks = n;
+		// Смещения блоков возрастают, размеры - 16 * b
+		uint64_t prev = sizeof(PackedHeader);
+		for (size_t b = 0; b < blocks; b++) {
+			uint64_t from = Entry(b).offset;
+			uint64_t to = BlockEnd(b);
+			uint64_t bits = to >= from ? (to - from) / 16 : 0;
+			if (from != prev || to < from || (to - from) % 16 != 0
+					|| (bits > 32 && bits != PACKED_RAW_BITS)) {
+				data = NULL;
+				return false;
+			}
+			prev = to;
+		}
+		return true;
+	}
+
+	uint64_t Size() const { return header.count; }
+	size_t Blocks() const { return blocks; }
+	int Type() const { return header.type; }
+
+	// Распаковать блок b в out (до PACKED_BLOCK чисел). Возвращает число чисел в блоке.
+	template<typename T>
+	int DecodeBlock(size_t b, T *out) const {
+		static const PackFn *unpack = UnpackTable(std::make_index_sequence<33>());
+		PackedIndex e = Entry(b);
+		int n = b + 1 < blocks ? PACKED_BLOCK : (int)(header.count - (uint64_t)b * PACKED_BLOCK);
+		int bits = (int)((BlockEnd(b) - e.offset) / 16);
+		const char *p = data + e.offset;
+		int64_t x = e.first;
+		out[0] = (T)x;
+		if (bits == PACKED_RAW_BITS) {
+			for (int i = 1; i < n; i++) {
+				uint64_t d;
+				memcpy(&d, p + 8 * i, 8);
+				x += (int64_t)LittleEndian(d);
+				out[i] = (T)x;
+			}
+			return n;
+		}
+		uint32_t words[PACKED_BLOCK];
+		uint32_t delta[PACKED_BLOCK];
+		memcpy(words, p, 16 * bits);
+		unpack[bits](words, delta);
+		for (int i = 1; i < n; i++) {
+			x += delta[i];
+			out[i] = (T)x;
+		}
+		return n;
+	}
+
+	// i-е число (распаковывается только его блок)
+	int64_t Get(uint64_t i) const {
+		int64_t v[PACKED_BLOCK];
+		DecodeBlock((size_t)(i / PACKED_BLOCK), v);
+		return v[i % PACKED_BLOCK];
+	}
+
+	// Номер первого числа, не меньшего x (Size(), если такого нет).
+	// Двоичный поиск по первым числам блоков, потом по одному блоку.
+	uint64_t LowerBound(int64_t x) const {
+		// Последний блок, первое число которого меньше x
+		size_t lo = 0;
+		size_t hi = blocks;
+		while (lo < hi) {
+			size_t mid = (lo + hi) / 2;
+			if (Entry(mid).first < x) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+		if (lo == 0) {
+			return 0;
+		}
+		size_t b = lo - 1;
+		int64_t v[PACKED_BLOCK];
+		int n = DecodeBlock(b, v);
+		int i = 0;
+		while (i < n && v[i] < x) {
+			i++;
+		}
+		return (uint64_t)b * PACKED_BLOCK + i;
+	}
+
+	// Распаковать всё в конец v
+	template<typename T>
+	void Decode(std::vector<T> &v) const {
+		size_t old = v.size();
+		v.resize(old + header.count);
+		for (size_t b = 0; b < blocks; b++) {
+			DecodeBlock(b, &v[old + b * PACKED_BLOCK]);
+		}
+	}
+};
+
+// Записать отсортированный массив в сжатый файл name. false - ошибка записи
+// или массив не отсортирован.
+template<typename T>
+bool WritePackedFile(const char *name, const std::vector<T> &v) {
+	FILE *f = fopen(name, "wb");
+	if (f == NULL) {
+		return false;
+	}
+	PackedWriter writer(f, sizeof(T) == 4 ? BINARY_INT32 : BINARY_INT64);
+	bool ok = true;
+	for (size_t i = 0; ok && i < v.size(); i++) {
+		ok = writer.Write(v[i]);
+	}
+	ok = writer.Close() && ok;
+	return fclose(f) == 0 && ok;
+}
@@ -0,0 +1,6 @@
+#ifndef PACKED_ARRAY_INCLUDED
+#define PACKED_ARRAY_INCLUDED
+
+#include "packed_array.cpp"
+
+#endif
@@ -0,0 +1,125 @@
+// Параллельный вывод массива чисел текстом
+// Полный вывод отсортированного массива - это миллиарды символов, и перевод чисел в текст
+// в одном потоке занимает больше, чем сама параллельная сортировка. Здесь массив делится
+// на куски по PARALLEL_WRITE_CHUNK чисел, каждый кусок переводится в текст в свой буфер
+// в отдельном потоке, а готовые буферы пишутся по порядку большими вызовами write -
+// в файл или в stdout (в том числе в канал). Пока пишется один кусок, следующие уже
+// переводятся; одновременно в памяти не больше 2 кусков на поток.
+#include <vector>
+#include <deque>
+#include <future>
+#include <thread>
+#include <type_traits>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+// Чисел в куске
+#define PARALLEL_WRITE_CHUNK (64 * 1024)
+
+// Пары цифр 00..99 - перевод по две цифры за деление
+static const char DIGIT_PAIRS[] =
+	"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+	"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+// Записать x в p десятичными цифрами (со знаком), вернуть позицию после числа.
+// Нужно не больше 20 байт.
+template<typename T>
+inline char *FormatNumber(char *p, T x) {
+	typedef typename std::make_unsigned<T>::type U;
+	U u = (U)x;
+	if constexpr (std::is_signed<T>::value) {
+		if (x < 0) {
+			*p++ = '-';
+			u = 0 - u;
+		}
+	}
+	// Цифры с конца во временный буфер
+	char tmp[20];
+	int i = sizeof(tmp);
+	while (u >= 100) {
+		unsigned r = (unsigned)(u % 100);
+		u /= 100;
+		i -= 2;
+		memcpy(tmp + i, DIGIT_PAIRS + 2 * r, 2);
+	}
+	if (u >= 10) {
+		i -= 2;
+		memcpy(tmp + i, DIGIT_PAIRS + 2 * u, 2);
+	} else {
+		tmp[--i] = (char)('0' + u);
+	}
+	memcpy(p, tmp + i, sizeof(tmp) - i);
+	return p + sizeof(tmp) - i;
+}
+
+// Записать в fd все size байт. false - ошибка записи.
+inline bool WriteAll(int fd, const char *p, size_t size) {
+	while (size > 0) {
+		ssize_t r = write(fd, p, size);
+		if (r < 0 && errno == EINTR) {
+			continue;
+		}
+		if (r <= 0) {
+			return false;
+		}
+		p += r;
+		size -= r;
+	}
+	return true;
+}
+
+// Записать в fd текстом v[step - 1], v[2 * step - 1], ... (каждое step-е число),
+// после каждого числа - separator. threads == 0 - по числу ядер.
+// false - ошибка записи.
+template<typename T>
+bool WriteNumbers(int fd, const std::vector<T> &v, size_t step = 1, char separator = ' ', int threads = 0) {
+	if (step == 0) {
+		return false;
+	}
+	size_t count = v.size() / step;
+	size_t chunks = (count + PARALLEL_WRITE_CHUNK - 1) / PARALLEL_WRITE_CHUNK;
+
+	// Перевести кусок c в текст
+	auto format = [&v, step, separator, count](size_t c) {
+		size_t from = c * PARALLEL_WRITE_CHUNK;
+		size_t to = from + PARALLEL_WRITE_CHUNK < count ? from + PARALLEL_WRITE_CHUNK : count;
+		std::vector<char> out((to - from) * 21);
+		char *p = &out[0];
+		for (size_t k = from; k < to; k++) {
+			p = FormatNumber(p, v[(k + 1) * step - 1]);
+			*p++ = separator;
+		}
+		out.resize(p - &out[0]);
+		return out;
+	};
+
+	int p = threads > 0 ? threads : (int)std::thread::hardware_concurrency();
+	if (p <= 1 || chunks <= 1) {
+		for (size_t c = 0; c < chunks; c++) {
+			std::vector<char> out = format(c);
+			if (!WriteAll(fd, &out[0], out.size())) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Очередь кусков в работе; пишем всегда первый, освободившееся место - следующему куску
+	std::deque<std::future<std::vector<char> > > pending;
+	size_t next = 0;
+	while (next < chunks && pending.size() < 2 * (size_t)p) {
+		pending.push_back(std::async(std::launch::async, format, next++));
+	}
+	bool ok = true;
+	while (!pending.empty()) {
+		std::vector<char> out = pending.front().get();
+		pending.pop_front();
+		if (ok && next < chunks) {
+			pending.push_back(std::async(std::launch::async, format, next++));
+		}
+		ok = ok && WriteAll(fd, &out[0], out.size());
+	}
+	return ok;
+}
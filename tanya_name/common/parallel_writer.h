@@ -0,0 +1,6 @@
+#ifndef PARALLEL_WRITER_INCLUDED
+#define PARALLEL_WRITER_INCLUDED
+
+#include "parallel_writer.cpp"
+
+#endif
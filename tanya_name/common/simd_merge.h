@@ -0,0 +1,9 @@
+#ifndef SIMD_MERGE_INCLUDED
+#define SIMD_MERGE_INCLUDED
+
+#include "simd_merge.cpp"
+
+inline int MergeSorted(const int32_t *a, int n, const int32_t *b, int m, int32_t *out, int limit);
+inline int MergeSorted(const int64_t *a, int n, const int64_t *b, int m, int64_t *out, int limit);
+
+#endif
@@ -2,6 +2,8 @@
 #include <iostream>
 #include <vector>
 
+#include "../common/fast_input.h"
+
 // Проходим много раз по массиву, проверяя порядок соседних элементов и меняя их
 // местами, если порядок нарушен.
 // Псевдокод: http://en.wikipedia.org/wiki/Bubble_sort#Pseudocode_implementation
@@ -31,11 +33,8 @@ int main()
 	std::vector<int> v;
 	
 	// read numbers until end-of-file
-	while( !std::cin.eof() ) {
-		int i = 0;
-		std::cin >> i;
-		v.push_back(i);
-	}
+	FastInput in;
+	in.ReadAll(v);
 	
 	Sort(v);
 	
@@ -2,6 +2,8 @@
 #include <iostream>
 #include <vector>
 
+#include "../common/fast_input.h"
+
 // Идём с начала массива, для каждого элемента пытаемся найти, куда его вставить
 // в уже отсортированную часть.
 // Псевдокод: http://www.ee.ryerson.ca/~courses/coe428/sorting/insertionsort.html
@@ -26,11 +28,8 @@ int main()
 	std::vector<int> v;
 	
 	// read numbers until end-of-file
-	while( !std::cin.eof() ) {
-		int i = 0;
-		std::cin >> i;
-		v.push_back(i);
-	}
+	FastInput in;
+	in.ReadAll(v);
 	
 	Sort(v);
 
@@ -2,6 +2,8 @@
 #include <iostream>
 #include <vector>
 
+#include "../common/fast_input.h"
+
 // Многократно находим в неотсортированной части массива минимальный элемент,
 // подставляем его в конец отсортированной части.
 void Sort(std::vector<int> &v) {
@@ -30,11 +32,8 @@ int main()
 	std::vector<int> v;
 	
 	// read numbers until end-of-file
-	while( !std::cin.eof() ) {
-		int i = 0;
-		std::cin >> i;
-		v.push_back(i);
-	}
+	FastInput in;
+	in.ReadAll(v);
 	
 	Sort(v);
 	
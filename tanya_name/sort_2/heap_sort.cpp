@@ -1,6 +1,10 @@
 // Пирамидальная сортировка
 #include <iostream>
 #include <vector>
+#include <utility>
+#include <functional>
+
+#include "../common/heap_sift.h"
 
 inline int left(int i) { return (i * 2) + 1; }
 inline int right(int i) { return (i * 2) + 2; }
@@ -10,34 +14,111 @@ inline int parent(int i) { return (i - 1) / 2; }
 // Второй проход - переносим n раз максимум кучи в конец массива,
 //   уменьшая размер кучи на 1, восстанавливаем свойство оставшейся кучи
 // Алгоритм: http://ru.wikipedia.org/wiki/%D0%9F%D0%B8%D1%80%D0%B0%D0%BC%D0%B8%D0%B4%D0%B0%D0%BB%D1%8C%D0%BD%D0%B0%D1%8F_%D1%81%D0%BE%D1%80%D1%82%D0%B8%D1%80%D0%BE%D0%B2%D0%BA%D0%B0#.D0.90.D0.BB.D0.B3.D0.BE.D1.80.D0.B8.D1.82.D0.BC
+// Просейки общие с очередью с приоритетами (common/heap_queue.cpp) - см. heap_sift.cpp
 template<typename T> 
 inline void RestoreHeap(std::vector<T> &v, int p, int n) {
 	// Восстанавливаем свойство кучи - родительские элементы должны быть больше дочерних
-	while ((left(p) < n && v[p] < v[left(p)]) || // Левый элемент больше родительского 
-				(right(p) < n && v[p] < v[right(p)])) { // Правый элемент в куче и больше род.
-		
-		// Мы попали в этот цикл => один из дочерних элементов гарантированно больше родительского
-		int max = left(p);
-		if (right(p) < n && v[right(p)] > v[max]) {
-			max = right(p);
+	if (p >= n) {
+		return;
+	}
+	SiftDown(v.data(), p, n, std::less<T>());
+}
+
+// Восходящая (bottom-up) просейка: около n log n сравнений вместо 2 n log n
+template<typename T>
+inline void RestoreHeapBottomUp(std::vector<T> &v, int p, int n) {
+	if (p >= n) {
+		return;
+	}
+	T x = std::move(v[p]);
+	SiftDownBottomUp(v.data(), p, n, std::move(x), std::less<T>());
+}
+
+// 4-арная куча: дети вершины i - 4i + 1 .. 4i + 4. Высота кучи в 2 раза меньше,
+// а все 4 ребёнка лежат рядом - одна кэш-линия на уровень вместо двух.
+// Куча строится в отдельном буфере со сдвигом pad, подобранным так, чтобы каждая четвёрка
+// детей начиналась с адреса, кратного 4 * sizeof(T) (и не пересекала границу кэш-линии).
+inline int child4(int i) { return (i * 4) + 1; }
+
+// Просейка с "дыркой": элемент не меняется местами на каждом уровне,
+// а запоминается и ставится один раз в конце
+template<typename T>
+inline void RestoreHeap4(T *h, int p, int n) {
+	T x = std::move(h[p]);
+	while (true) {
+		int c = child4(p);
+		if (c >= n) {
+			break;
+		}
+		// Максимальный из (до) 4 детей
+		int last = (c + 4 < n) ? c + 4 : n;
+		int max = c;
+		for (int k = c + 1; k < last; k++) {
+			if (h[max] < h[k]) {
+				max = k;
+			}
 		}
-		// Максимальный элемент перемещаем в родительский
-		T temp = v[p];
-		v[p] = v[max];
-		v[max] = temp;
-		// В следующей итерации цикла восстанавливаем порядок для новой вершины
+		if (!(x < h[max])) {
+			break;
+		}
+		h[p] = std::move(h[max]);
 		p = max;
 	}
+	h[p] = std::move(x);
 }
 
-template<typename T> void Sort(std::vector<T> &v) {
+template<typename T> void Sort4(std::vector<T> &v) {
+	int n = (int)v.size();
+	if (n <= 1) {
+		return;
+	}
+	
+	// Выравниваем: элемент i кучи лежит в buf[pad + i], дети 4i + 1.. - с выровненного адреса
+	std::vector<T> buf(n + 3);
+	size_t k = (size_t)&buf[0] / sizeof(T);
+	int pad = (int)((8 - 1 - (k % 4)) % 4);
+	T *h = &buf[pad];
+	for (int i = 0; i < n; i++) {
+		h[i] = std::move(v[i]);
+	}
+	
+	for (int i = (n - 2) / 4; i >= 0; i--) {
+		RestoreHeap4(h, i, n);
+	}
+	for (int i = n - 1; i >= 1; i--) {
+		std::swap(h[0], h[i]);
+		RestoreHeap4(h, 0, i);
+	}
+	
+	for (int i = 0; i < n; i++) {
+		v[i] = std::move(h[i]);
+	}
+}
+
+// Вариант кучи для Sort
+enum HeapKind {
+	BINARY_HEAP, // Обычная двоичная куча
+	BOTTOM_UP_HEAP, // Двоичная куча с восходящей просейкой
+	QUATERNARY_HEAP // 4-арная выровненная куча
+};
+
+template<typename T> void Sort(std::vector<T> &v, HeapKind kind) {
+	if (kind == QUATERNARY_HEAP) {
+		Sort4(v);
+		return;
+	}
+	
 	int n = (int)v.size();
 	
 	// Идём по дочерним вершинам с конца массива, переносим максимальное 
 	// значение в родительскую вершину
 	for (int i = n / 2; i >= 0; i--) {
 		// Восстановить свойство i-й вершины
-		RestoreHeap(v, i, n);
+		if (kind == BOTTOM_UP_HEAP) {
+			RestoreHeapBottomUp(v, i, n);
+		} else {
+			RestoreHeap(v, i, n);
+		}
 		
 		// Отладка - проверка отношений родителя и детей
 		// if (i != parent(left(i)) || i != parent(right(i))
@@ -57,15 +138,21 @@ template<typename T> void Sort(std::vector<T> &v) {
 	for (int i = n - 1; i >= 1; i--) {
 		// i - это новый размер кучи
 		// Максимум (то есть, первый элемент кучи) меняем с последним элементом кучи
-		T temp = v[0];
-		v[0] = v[i];
-		v[i] = temp;
+		std::swap(v[0], v[i]);
 		
 		// Восстанавливаем свойство в максимуме
-		RestoreHeap(v, 0, i);
+		if (kind == BOTTOM_UP_HEAP) {
+			RestoreHeapBottomUp(v, 0, i);
+		} else {
+			RestoreHeap(v, 0, i);
+		}
 	}
 }
 
+template<typename T> void Sort(std::vector<T> &v) {
+	Sort(v, BINARY_HEAP);
+}
+
 // Раскомментировать для теста сортировки
 /*
 int main()
@@ -98,4 +185,4 @@ int main()
 	}
 	std::cout << std::endl;
 }
-/*
\ No newline at end of file
+*/
\ No newline at end of file
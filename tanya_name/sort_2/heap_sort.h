@@ -1,3 +1,4 @@
 #include "heap_sort.cpp"
 
-template<typename T> void Sort(std::vector<T> &v);
\ No newline at end of file
+template<typename T> void Sort(std::vector<T> &v);
+template<typename T> void Sort(std::vector<T> &v, HeapKind kind);
\ No newline at end of file
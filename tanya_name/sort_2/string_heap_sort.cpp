@@ -5,6 +5,8 @@
 
 // Модульность - это круто!
 #include "heap_sort.h"
+#include "string_sort.h"
+#include "../common/fast_input.h"
 
 int main()
 {
@@ -13,18 +15,17 @@ int main()
 	
 	std::vector<std::string> v;
 	
-	// Считать количество строк ввода
+	// Считать количество строк ввода и сами строки (память под n строк выделяется сразу)
+	FastInput in;
 	int n = 0;
-	std::cin >> n;
-	// read strings until end-of-file
-	while(!std::cin.eof() && n > 0) {
-		--n;
-		std::string s;
-		std::cin >> s;
-		v.push_back(s);
-	}
+	in.Read(n);
+	in.Read(v, n);
 	
-	Sort(v);
+	// Сортировка по 8-байтовым префиксам - к строкам обращаемся только при равных префиксах.
+	// Для другой сортировки - закомментировать и раскомментировать одну из следующих строк.
+	PrefixStringSort(v);
+	// StringSort(v); // Многоключевая быстрая сортировка
+	// Sort(v); // Пирамидальная сортировка
 	
 	// print an array
 	for(std::vector<std::string>::iterator it = v.begin(); it != v.end(); ++it) {
@@ -0,0 +1,181 @@
+// Сортировка строк: многоключевая быстрая сортировка (3-way radix quicksort)
+// и поразрядная MSD сортировка по первым байтам для больших массивов
+// Обычная сортировка сравнивает строки целиком с первого символа, хотя у соседних
+// (после нескольких шагов) строк длинный общий префикс. Здесь строки делятся по одному
+// символу на глубине d: на меньшие, равные и большие опорного. Равные по символу d дальше
+// сравниваются только начиная с d + 1 - уже совпавший префикс больше не просматривается.
+// Алгоритм: Bentley, Sedgewick - Fast Algorithms for Sorting and Searching Strings
+// http://www.cs.princeton.edu/~rs/strings/paper.pdf
+#include <vector>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <stdint.h>
+
+// Куски меньше этого размера сортируем вставками
+#define STRING_INSERTION_SIZE 16
+// Куски больше этого размера сначала раскладываем по корзинам по символу d (MSD radix)
+#define STRING_RADIX_SIZE (16 * 1024)
+
+// Символ строки на глубине d; -1 - строка кончилась (меньше любого символа)
+inline int CharAt(const std::string &s, size_t d) {
+	return d < s.size() ? (unsigned char)s[d] : -1;
+}
+
+// Сортировка вставками с известным общим префиксом длины d
+inline void StringInsertionSort(std::string *a, int n, size_t d) {
+	for (int i = 1; i < n; i++) {
+		for (int j = i; j > 0 && a[j].compare(d, std::string::npos, a[j - 1], d, std::string::npos) < 0; j--) {
+			a[j].swap(a[j - 1]); // Обмен указателями, без копирования символов
+		}
+	}
+}
+
+// Медиана трёх чисел
+inline int Median3(int a, int b, int c) {
+	if (a < b) {
+		return b < c ? b : (a < c ? c : a);
+	}
+	return a < c ? a : (b < c ? c : b);
+}
+
+inline void MultikeyQuicksort(std::string *a, int n, size_t d);
+
+// MSD radix: раскладываем a[0..n) по 257 корзинам (конец строки и 256 значений символа d),
+// каждую корзину сортируем дальше начиная с d + 1
+inline void MsdRadixSort(std::string *a, int n, size_t d, std::vector<std::string> &tmp) {
+	int count[258] = {0};
+	for (int i = 0; i < n; i++) {
+		count[CharAt(a[i], d) + 2]++;
+	}
+	// count[c + 1] - начало корзины символа c
+	for (int c = 0; c < 257; c++) {
+		count[c + 1] += count[c];
+	}
+	if ((int)tmp.size() < n) {
+		tmp.resize(n);
+	}
+	for (int i = 0; i < n; i++) {
+		tmp[count[CharAt(a[i], d) + 1]++].swap(a[i]);
+	}
+	for (int i = 0; i < n; i++) {
+		a[i].swap(tmp[i]);
+	}
+
+	// Корзина кончившихся строк (count[0]) уже отсортирована - все строки равны
+	for (int c = 1; c < 257; c++) {
+		int from = count[c - 1];
+		int size = count[c] - from;
+		if (size > STRING_RADIX_SIZE) {
+			MsdRadixSort(a + from, size, d + 1, tmp);
+		} else {
+			MultikeyQuicksort(a + from, size, d + 1);
+		}
+	}
+}
+
+// Строки a[0..n) имеют общий префикс длины d
+inline void MultikeyQuicksort(std::string *a, int n, size_t d) {
+	while (n > 1) {
+		if (n < STRING_INSERTION_SIZE) {
+			StringInsertionSort(a, n, d);
+			return;
+		}
+
+		// Опорный символ - медиана символов первой, средней и последней строки
+		int pivot = Median3(CharAt(a[0], d), CharAt(a[n / 2], d), CharAt(a[n - 1], d));
+
+		// Разбиение Дейкстры на три части: [0, lt) < pivot, [lt, gt) == pivot, [gt, n) > pivot
+		int lt = 0;
+		int gt = n;
+		int i = 0;
+		while (i < gt) {
+			int c = CharAt(a[i], d);
+			if (c < pivot) {
+				a[lt++].swap(a[i++]);
+			} else if (c > pivot) {
+				a[i].swap(a[--gt]);
+			} else {
+				i++;
+			}
+		}
+
+		MultikeyQuicksort(a, lt, d);
+		// Равные по символу d сравниваем дальше с d + 1 (если строки не кончились)
+		if (pivot >= 0) {
+			MultikeyQuicksort(a + lt, gt - lt, d + 1);
+		}
+		// Хвостовая рекурсия для больших
+		a += gt;
+		n -= gt;
+	}
+}
+
+inline void StringSort(std::vector<std::string> &v) {
+	int n = (int)v.size();
+	if (n <= 1) {
+		return;
+	}
+	if (n > STRING_RADIX_SIZE) {
+		std::vector<std::string> tmp;
+		MsdRadixSort(&v[0], n, 0, tmp);
+	} else {
+		MultikeyQuicksort(&v[0], n, 0);
+	}
+}
+
+
+// Сортировка строк по 8-байтовым префиксам
+// Сравнение std::string - переход по указателю в кучу за символами, и на больших массивах
+// это промах кэша на каждое сравнение. Поэтому сначала строим компактный массив пар
+// {первые 8 байт строки как число big-endian, номер строки} и сортируем его сравнением чисел:
+// порядок чисел совпадает с лексикографическим порядком префиксов. К самим строкам
+// обращаемся только при равных префиксах. В конце строки переставляются один раз.
+struct PrefixKey {
+	uint64_t prefix;
+	uint32_t index;
+};
+
+// Первые 8 байт строки (недостающие - нули) как число, старший байт - первый символ
+inline uint64_t Prefix8(const std::string &s) {
+	uint64_t r = 0;
+	size_t n = s.size() < 8 ? s.size() : 8;
+	for (size_t i = 0; i < n; i++) {
+		r |= (uint64_t)(unsigned char)s[i] << (56 - 8 * i);
+	}
+	return r;
+}
+
+inline void PrefixStringSort(std::vector<std::string> &v) {
+	int n = (int)v.size();
+	if (n <= 1) {
+		return;
+	}
+
+	std::vector<PrefixKey> keys(n);
+	for (int i = 0; i < n; i++) {
+		keys[i].prefix = Prefix8(v[i]);
+		keys[i].index = (uint32_t)i;
+	}
+
+	std::sort(keys.begin(), keys.end(), [&v](const PrefixKey &a, const PrefixKey &b) {
+		if (a.prefix != b.prefix) {
+			return a.prefix < b.prefix;
+		}
+		// Равные префиксы: первые 8 байт уже совпали, сравниваем остаток.
+		// Короткие строки сравниваем целиком - "ab" и "ab\0" имеют одинаковый префикс.
+		const std::string &x = v[a.index];
+		const std::string &y = v[b.index];
+		if (x.size() > 8 && y.size() > 8) {
+			return x.compare(8, std::string::npos, y, 8, std::string::npos) < 0;
+		}
+		return x < y;
+	});
+
+	// Переставляем строки один раз (перемещением, без копирования символов)
+	std::vector<std::string> sorted(n);
+	for (int i = 0; i < n; i++) {
+		sorted[i].swap(v[keys[i].index]);
+	}
+	v.swap(sorted);
+}
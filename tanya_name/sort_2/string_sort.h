@@ -0,0 +1,6 @@
+#ifndef STRING_SORT_INCLUDED
+#define STRING_SORT_INCLUDED
+
+#include "string_sort.cpp"
+
+#endif
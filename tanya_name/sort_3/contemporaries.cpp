@@ -2,11 +2,26 @@
 #include <iostream>
 #include <vector>
 #include <list>
+#include <algorithm>
+#include <climits>
 #include <stdint.h>
 #include "stdio.h"
 
 
-#include "merge_sort.h"
+#include "parallel_merge_sort.h"
+#include "interval_index.h"
+#include "../common/calendar.h"
+#include "../common/date_parser.h"
+
+// Способ подсчёта максимального числа пересечений:
+// 0 - сортировка по дате рождения и проход по списку актуальных интервалов (до O(n^2))
+// 1 - заметание прямой по отсортированным поразрядной сортировкой событиям (O(n))
+// 2 - разностный массив по дням календаря, без сортировки (O(n + D), D - число дней)
+// Раскомментировать и указать 1 или 2 для другого способа; по умолчанию - 0
+//#define INTERSECT_ENGINE 1
+#ifndef INTERSECT_ENGINE
+#define INTERSECT_ENGINE 0
+#endif
 
 // Дату мы перегоним в формат "20140608" - число от 0 до <= 31 + 12 * 100 + 9999 * 10000 < 100.000.000
 // 100 миллионов даже влезут в знаковый int
@@ -70,29 +85,253 @@ int GetMaxIntersect(std::vector<int64_t> &v) {
 	return max;
 }
 
+// Поразрядная (LSD) сортировка 32-битных чисел: 3 прохода по 11 бит
+// http://en.wikipedia.org/wiki/Radix_sort#Least_significant_digit_radix_sorts
+void RadixSort(std::vector<uint32_t> &v) {
+	const int BITS = 11;
+	const int BUCKETS = 1 << BITS;
+	std::vector<uint32_t> buf(v.size());
+	std::vector<int> count(BUCKETS);
+	for (int shift = 0; shift < 32; shift += BITS) {
+		// Считаем количество элементов в каждой корзине
+		std::fill(count.begin(), count.end(), 0);
+		for (size_t i = 0; i < v.size(); i++) {
+			count[(v[i] >> shift) & (BUCKETS - 1)]++;
+		}
+		// Все элементы в одной корзине - этот разряд ничего не меняет
+		if (count[(v.empty() ? 0 : v[0] >> shift) & (BUCKETS - 1)] == (int)v.size()) {
+			continue;
+		}
+		// Начало каждой корзины в выходном массиве
+		int sum = 0;
+		for (int b = 0; b < BUCKETS; b++) {
+			int c = count[b];
+			count[b] = sum;
+			sum += c;
+		}
+		// Раскладываем по корзинам, сохраняя порядок внутри корзины
+		for (size_t i = 0; i < v.size(); i++) {
+			buf[count[(v[i] >> shift) & (BUCKETS - 1)]++] = v[i];
+		}
+		v.swap(buf);
+	}
+}
+
+// То же, что GetMaxIntersect, но методом заметающей прямой. Сортировка не нужна.
+// Каждый дожил до 18 лет - это интервал [18-летие, смерть) (если смерть в день 18-летия -
+// только сам этот день). Превращаем интервал в 2 события: начало (+1) и конец (-1),
+// сортируем события по дате, в одну дату сначала идут концы, и считаем текущую сумму.
+// Её максимум и есть максимальное число пересекающихся интервалов.
+int GetMaxIntersectSweep(const std::vector<int64_t> &v) {
+	int n = (int)v.size();
+	
+	// Событие - дата, сдвинутая на 1 бит влево, в младшем бите 1 - начало, 0 - конец.
+	// Даты меньше 10^8 < 2^27, поэтому событие влезает в 32 бита.
+	std::vector<uint32_t> events;
+	events.reserve(2 * n);
+	for (int i = 0; i < n; i++) {
+		int from = birth(v[i]) + 180000;
+		int to = death(v[i]);
+		if (from > to) {
+			continue; // Не дожил до 18 лет
+		}
+		if (to == from) {
+			to = from + 1; // Только один день - конец сразу после него
+		}
+		events.push_back(((uint32_t)from << 1) | 1);
+		events.push_back((uint32_t)to << 1);
+	}
+	
+	RadixSort(events);
+	
+	int max = 0;
+	int cur = 0;
+	for (size_t i = 0; i < events.size(); i++) {
+		if (events[i] & 1) {
+			if (++cur > max) {
+				max = cur;
+			}
+		} else {
+			--cur;
+		}
+	}
+	
+	return max;
+}
+
+// Интервал взрослой жизни в номерах полудней (HalfDayOrdinal): [from, to).
+// Возвращает false, если не дожил до 18. 18-летие родившегося 29 февраля в невисокосный
+// год - между 28 февраля и 1 марта, как и в упакованных датах других способов подсчёта.
+inline bool AdultDays(int64_t pair, int &from, int &to) {
+	if (birth(pair) + 180000 > death(pair)) {
+		return false;
+	}
+	from = HalfDayOrdinal(birth(pair) + 180000);
+	to = HalfDayOrdinal(death(pair));
+	if (to <= from) {
+		to = from + 1; // Только один день
+	}
+	return true;
+}
+
+// То же, что GetMaxIntersect, но через разностный массив по календарю.
+// Каждый поток для своей части людей строит свой массив diff (+1 в день 18-летия,
+// -1 в день смерти) - без атомарных операций. Потом массивы складываются (тоже параллельно
+// по кускам календаря) и считаются префиксные суммы - это число живых взрослых в каждый день.
+// Календарь - в полуднях: дню k соответствует элемент 2 * k, нечётные - несуществующие 29.02.
+// Если curve != NULL, туда записывается это число для всех полудней начиная с *firstDay.
+int GetMaxIntersectCalendar(const std::vector<int64_t> &v,
+		std::vector<int> *curve = NULL, int *firstDay = NULL) {
+	int n = (int)v.size();
+	int p = (int)std::thread::hardware_concurrency();
+	if (p < 1 || n < PARALLEL_MIN_SIZE) {
+		p = 1;
+	}
+	
+	// Границы календаря - минимум и максимум по каждому потоку
+	std::vector<int> lo(p, INT_MAX);
+	std::vector<int> hi(p, INT_MIN);
+	RunThreads(p, [&](int t) {
+		int end = (int)((int64_t)n * (t + 1) / p);
+		for (int i = (int)((int64_t)n * t / p); i < end; i++) {
+			int from, to;
+			if (AdultDays(v[i], from, to)) {
+				lo[t] = std::min(lo[t], from);
+				hi[t] = std::max(hi[t], to);
+			}
+		}
+	});
+	int first = *std::min_element(lo.begin(), lo.end());
+	int last = *std::max_element(hi.begin(), hi.end());
+	if (first > last) {
+		return 0; // Никто не дожил до 18 лет
+	}
+	int days = last - first + 1;
+	
+	// Разностные массивы каждого потока
+	std::vector<std::vector<int> > diff(p);
+	RunThreads(p, [&](int t) {
+		diff[t].assign(days, 0);
+		int end = (int)((int64_t)n * (t + 1) / p);
+		for (int i = (int)((int64_t)n * t / p); i < end; i++) {
+			int from, to;
+			if (AdultDays(v[i], from, to)) {
+				diff[t][from - first]++;
+				diff[t][to - first]--;
+			}
+		}
+	});
+	
+	// Складываем в diff[0], каждый поток - свой кусок календаря
+	RunThreads(p, [&](int t) {
+		int end = (int)((int64_t)days * (t + 1) / p);
+		for (int d = (int)((int64_t)days * t / p); d < end; d++) {
+			for (int k = 1; k < p; k++) {
+				diff[0][d] += diff[k][d];
+			}
+		}
+	});
+	
+	// Префиксные суммы - число живых в каждый день
+	std::vector<int> &alive = diff[0];
+	int max = 0;
+	int cur = 0;
+	for (int d = 0; d < days; d++) {
+		cur += alive[d];
+		alive[d] = cur;
+		if (cur > max) {
+			max = cur;
+		}
+	}
+	
+	if (curve != NULL) {
+		curve->swap(alive);
+	}
+	if (firstDay != NULL) {
+		*firstDay = first;
+	}
+	return max;
+}
+
 int main()
 {
 	// comment this line for reading from stdin
 	freopen("dates.txt", "r", stdin);
 	
+	// Разбираем вход прямо в памяти, без std::cin
+	FastInput input;
+	DateParser parser(input);
+	
 	std::vector<int64_t> v;
 	
 	int n = 0;
-	std::cin >> n;
-	while( !std::cin.eof() && n > 0 ) {
-		--n;
-		// формат: день месяц год день месяц год
-		int d, m, y, birthday, dayOfDeath;
-		std::cin >> d >> m >> y;
-		birthday = d + m * 100 + y * 10000;
-		std::cin >> d >> m >> y;
-		dayOfDeath = d + m * 100 + y * 10000;
-		int64_t i = ((int64_t)birthday << 32) + dayOfDeath;
-		v.push_back(i);
-	}
-	
-	// Отсортировать по дате рождения
-	Sort<int64_t>(v);
+	parser.NextInt(n);
+	v.reserve(n > 0 ? n : 0);
+	// формат: день месяц год день месяц год
+	// Запись с некорректной датой пропускаем (до конца строки) и читаем дальше
+	std::vector<int> skipped; // Номера пропущенных записей во входе (с 0)
+	int64_t i;
+	for (int record = 0; record < n; record++) {
+		if (parser.NextDatePair(i)) {
+			v.push_back(i);
+		} else if (parser.Bad()) {
+			skipped.push_back(record);
+			parser.SkipLine();
+			parser.ClearBad();
+		} else {
+			break; // Вход кончился раньше
+		}
+	}
+	if (!skipped.empty()) {
+		std::cerr << "Пропущено записей с некорректной датой: " << skipped.size()
+			<< " (первая - запись " << skipped[0] + 1 << ")" << std::endl;
+	}
+	
+	// Необязательное продолжение входа - запросы по одному в строке:
+	//   "? д м г" - сколько взрослых было живо в эту дату;
+	//   "# д м г д м г" - сколько взрослых жило хотя бы день в промежутке между датами (включительно);
+	//   "= д м г" - номера (с 1, в порядке входа) всех взрослых, живых в эту дату: сначала их число.
+	// Другие строки пропускаем. Запросы читаем до подсчёта: он сортирует v, а номерам нужен порядок входа.
+	std::vector<char> kinds; // Вид каждого запроса по порядку
+	std::vector<int> dates; // Запросы "?"
+	std::vector<std::pair<int, int> > ranges; // Запросы "#"
+	std::vector<int> enumerated; // Запросы "="
+	char op;
+	while (parser.NextChar(op)) {
+		int date;
+		int64_t range;
+		if (op == '?' && parser.NextPackedDate(date)) {
+			dates.push_back(date);
+		} else if (op == '#' && parser.NextDatePair(range)) {
+			ranges.push_back(std::make_pair(std::min(birth(range), death(range)), std::max(birth(range), death(range))));
+		} else if (op == '=' && parser.NextPackedDate(date)) {
+			enumerated.push_back(date);
+		} else {
+			parser.SkipLine();
+			continue;
+		}
+		kinds.push_back(op);
+	}
+	std::vector<int> alive;
+	std::vector<int> overlapping;
+	std::vector<std::vector<int> > lists(enumerated.size());
+	if (!kinds.empty()) {
+		IntervalIndex index(v);
+		index.CountAliveBatch(dates, alive);
+		index.CountOverlappingBatch(ranges, overlapping);
+		for (size_t i = 0; i < enumerated.size(); i++) {
+			index.Enumerate(enumerated[i], lists[i]);
+			std::sort(lists[i].begin(), lists[i].end());
+		}
+	}
+	
+#if INTERSECT_ENGINE == 1
+	std::cout << GetMaxIntersectSweep(v);
+#elif INTERSECT_ENGINE == 2
+	std::cout << GetMaxIntersectCalendar(v);
+#else
+	// Отсортировать по дате рождения (параллельно на всех ядрах)
+	ParallelSort<int64_t>(v);
 	
 	// Напечатать для тестовых целей, что получилось после сортировки
 	/*
@@ -102,5 +341,29 @@ int main()
 	*/
 	
 	std::cout << GetMaxIntersect(v);
+#endif
 	
-}
\ No newline at end of file
+	if (!kinds.empty()) {
+		std::cout << std::endl;
+		size_t a = 0, r = 0, e = 0;
+		for (size_t i = 0; i < kinds.size(); i++) {
+			if (kinds[i] == '?') {
+				std::cout << alive[a++];
+			} else if (kinds[i] == '#') {
+				std::cout << overlapping[r++];
+			} else {
+				// Номер в v -> номер во входе: сдвигаем на пропущенные записи перед ним
+				const std::vector<int> &list = lists[e++];
+				std::cout << list.size();
+				size_t s = 0;
+				for (size_t j = 0; j < list.size(); j++) {
+					while (s < skipped.size() && skipped[s] <= list[j] + (int)s) {
+						s++;
+					}
+					std::cout << " " << list[j] + s + 1;
+				}
+			}
+			std::cout << std::endl;
+		}
+	}
+}
@@ -0,0 +1,148 @@
+// Статический индекс интервалов "совершеннолетие - смерть" для пакетных запросов
+// "сколько взрослых было живо в дату X" и "сколько взрослых жило в промежутке [X, Y]".
+// Интервал человека - [18-летие, смерть), если смерть в день 18-летия - только сам этот день.
+//
+// Подсчёт: отсортированные массивы начал и концов. Жив в X <=> начало <= X и конец > X, поэтому
+// count(X) = (начал <= X) - (концов <= X) - два бинарных поиска, O(log n).
+// Перечисление: дерево интервалов на массиве, отсортированном по началу. Вершина - середина
+// отрезка массива, в ней храним максимальный конец по всему отрезку: если он <= X,
+// в отрезке никого живого нет, и мы его пропускаем. O(log n + k).
+// http://en.wikipedia.org/wiki/Interval_tree#Augmented_tree
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <stdint.h>
+
+#include "parallel_merge_sort.h"
+
+class IntervalIndex {
+	std::vector<int> starts; // Начала по возрастанию
+	std::vector<int> ends; // Концы по возрастанию
+
+	// Интервалы, отсортированные по началу, и их номера во входном массиве
+	std::vector<int64_t> byStart; // (начало << 32) + конец
+	std::vector<int> ids;
+	// maxEnd[mid] - максимальный конец на отрезке [lo, hi), серединой которого является mid
+	std::vector<int> maxEnd;
+
+	static inline int From(int64_t i) { return (int)(i >> 32); }
+	static inline int To(int64_t i) { return (int)(i & 0x00000000FFFFFFFF); }
+
+	// Построить дерево на отрезке [lo, hi), вернуть максимальный конец
+	int Build(int lo, int hi) {
+		if (lo >= hi) {
+			return 0;
+		}
+		int mid = lo + (hi - lo) / 2;
+		int m = To(byStart[mid]);
+		int l = Build(lo, mid);
+		int r = Build(mid + 1, hi);
+		maxEnd[mid] = std::max(m, std::max(l, r));
+		return maxEnd[mid];
+	}
+
+	void Collect(int lo, int hi, int date, std::vector<int> &out) const {
+		while (lo < hi) {
+			int mid = lo + (hi - lo) / 2;
+			// На отрезке все умерли не позже date
+			if (maxEnd[mid] <= date) {
+				return;
+			}
+			Collect(lo, mid, date, out);
+			// Правее середины начала ещё больше
+			if (From(byStart[mid]) > date) {
+				return;
+			}
+			if (To(byStart[mid]) > date) {
+				out.push_back(ids[mid]);
+			}
+			lo = mid + 1; // Хвостовая рекурсия для правой части
+		}
+	}
+
+public:
+	// pairs - даты рождения и смерти в формате contemporaries: (рождение << 32) + смерть
+	IntervalIndex(const std::vector<int64_t> &pairs) {
+		std::vector<std::pair<int64_t, int> > sorted;
+		for (int i = 0; i < (int)pairs.size(); i++) {
+			int from = (int)(pairs[i] >> 32) + 180000;
+			int to = (int)(pairs[i] & 0x00000000FFFFFFFF);
+			if (from > to) {
+				continue; // Не дожил до 18 лет
+			}
+			if (to == from) {
+				to = from + 1; // Только один день
+			}
+			starts.push_back(from);
+			ends.push_back(to);
+			sorted.push_back(std::make_pair(((int64_t)from << 32) + to, i));
+		}
+		ParallelSort(starts);
+		ParallelSort(ends);
+		ParallelSort(sorted);
+
+		int n = (int)sorted.size();
+		byStart.resize(n);
+		ids.resize(n);
+		for (int i = 0; i < n; i++) {
+			byStart[i] = sorted[i].first;
+			ids[i] = sorted[i].second;
+		}
+		maxEnd.resize(n);
+		Build(0, n);
+	}
+
+	// Сколько взрослых живо в дату date
+	int CountAlive(int date) const {
+		return (int)(std::upper_bound(starts.begin(), starts.end(), date) - starts.begin())
+			- (int)(std::upper_bound(ends.begin(), ends.end(), date) - ends.begin());
+	}
+
+	// Сколько взрослых было живо хотя бы один день из [from, to] (включительно)
+	int CountOverlapping(int from, int to) const {
+		// Начался не позже to и не кончился до from.
+		// Кончившиеся до from начались раньше from, поэтому их можно просто вычесть.
+		return (int)(std::upper_bound(starts.begin(), starts.end(), to) - starts.begin())
+			- (int)(std::upper_bound(ends.begin(), ends.end(), from) - ends.begin());
+	}
+
+	// Номера (во входном массиве) всех взрослых, живых в дату date
+	void Enumerate(int date, std::vector<int> &out) const {
+		out.clear();
+		Collect(0, (int)byStart.size(), date, out);
+	}
+
+	// Ответить на пакет запросов CountAlive параллельно. threads == 0 - по числу ядер.
+	void CountAliveBatch(const std::vector<int> &dates, std::vector<int> &result, int threads = 0) const {
+		result.resize(dates.size());
+		Batch((int)dates.size(), threads, [&](int i) {
+			result[i] = CountAlive(dates[i]);
+		});
+	}
+
+	// Ответить на пакет запросов CountOverlapping параллельно.
+	// ranges - пары (from, to), threads == 0 - по числу ядер.
+	void CountOverlappingBatch(const std::vector<std::pair<int, int> > &ranges, std::vector<int> &result,
+			int threads = 0) const {
+		result.resize(ranges.size());
+		Batch((int)ranges.size(), threads, [&](int i) {
+			result[i] = CountOverlapping(ranges[i].first, ranges[i].second);
+		});
+	}
+
+private:
+	// Вызвать answer(i) для i из [0, n), разбив запросы на равные части по потокам
+	template<typename Answer>
+	static void Batch(int n, int threads, Answer answer) {
+		int p = threads > 0 ? threads : (int)std::thread::hardware_concurrency();
+		if (p < 1 || n < PARALLEL_MIN_SIZE) {
+			p = 1;
+		}
+		RunThreads(p, [&](int t) {
+			int to = (int)((int64_t)n * (t + 1) / p);
+			for (int i = (int)((int64_t)n * t / p); i < to; i++) {
+				answer(i);
+			}
+		});
+	}
+};
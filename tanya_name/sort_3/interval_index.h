@@ -0,0 +1,6 @@
+#ifndef INTERVAL_INDEX_INCLUDED
+#define INTERVAL_INDEX_INCLUDED
+
+#include "interval_index.cpp"
+
+#endif
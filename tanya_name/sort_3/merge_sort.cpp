@@ -1,36 +1,26 @@
 // Сортировка слиянием
 #include <iostream>
 #include <vector>
+#include <iterator>
+#include <utility>
 
-// Рекурсивно сортируем две половины массива; сливаем две половины в одну.
-// Псевдокод: https://www.princeton.edu/~achaney/tmve/wiki100k/docs/Merge_sort.html
-template<typename T> void Sort(std::vector<T> &v) {
-	int n = (int)v.size();
-	
-	// Тривиальный случай - один элемент в массиве - он уже отсортирован
-	if (n <= 1) {
-		return;
-	}
-	
-	// Формируем два массива - левый и правый
-	int mid = n / 2; // Делим массив примерно поровну
-	std::vector<T> left(v.begin(), v.begin() + mid);
-	std::vector<T> right(v.begin() + mid, v.end());
-	// Сортируем оба
-	Sort<T>(left);
-	Sort<T>(right);
-	
-	// Сливаем в один (merge), идя с конца.
-	n--; // Устанавливаем на последний элемент
+#include "../common/simd_merge.h"
+
+// Слить отсортированные left и right в v, идя с конца.
+// Элементы перемещаются (left и right после слияния не нужны), поэтому для строк
+// и других "тяжёлых" типов слияние не выделяет память.
+template<typename T>
+void MergeHalves(std::vector<T> &left, std::vector<T> &right, std::vector<T> &v) {
+	int n = (int)v.size() - 1; // Устанавливаем на последний элемент
 	int i = (int)left.size() - 1;
 	int j = (int)right.size() - 1;
 	while (i >= 0 && j >= 0) {
 		// Сравниваем конечные элементы массивов, берём максимальный, добавляем в конец
 		if (left[i] > right[j]) {
-			v[n] = left[i];
+			v[n] = std::move(left[i]);
 			i--;
 		} else {
-			v[n] = right[j];
+			v[n] = std::move(right[j]);
 			j--;
 		}
 		n--;
@@ -38,11 +28,41 @@ template<typename T> void Sort(std::vector<T> &v) {
 	
 	// Один из массивов уже пуст - отработает лишь один из циклов
 	for (; i >= 0; i--) {
-		v[i] = left[i];
+		v[i] = std::move(left[i]);
 	}
 	for (; j >= 0; j--) {
-		v[j] = right[j];
+		v[j] = std::move(right[j]);
+	}
+}
+
+// Для целых ключей - векторное слияние без переходов
+inline void MergeHalves(std::vector<int32_t> &left, std::vector<int32_t> &right, std::vector<int32_t> &v) {
+	MergeSorted(&left[0], (int)left.size(), &right[0], (int)right.size(), &v[0], (int)v.size());
+}
+inline void MergeHalves(std::vector<int64_t> &left, std::vector<int64_t> &right, std::vector<int64_t> &v) {
+	MergeSorted(&left[0], (int)left.size(), &right[0], (int)right.size(), &v[0], (int)v.size());
+}
+
+// Рекурсивно сортируем две половины массива; сливаем две половины в одну.
+// Псевдокод: https://www.princeton.edu/~achaney/tmve/wiki100k/docs/Merge_sort.html
+template<typename T> void Sort(std::vector<T> &v) {
+	int n = (int)v.size();
+	
+	// Тривиальный случай - один элемент в массиве - он уже отсортирован
+	if (n <= 1) {
+		return;
 	}
+	
+	// Формируем два массива - левый и правый (перемещением элементов из v)
+	int mid = n / 2; // Делим массив примерно поровну
+	std::vector<T> left(std::make_move_iterator(v.begin()), std::make_move_iterator(v.begin() + mid));
+	std::vector<T> right(std::make_move_iterator(v.begin() + mid), std::make_move_iterator(v.end()));
+	// Сортируем оба
+	Sort<T>(left);
+	Sort<T>(right);
+	
+	// Сливаем в один (merge)
+	MergeHalves(left, right, v);
 }
 
 
@@ -0,0 +1,287 @@
+// Естественная сортировка слиянием (в стиле TimSort)
+// Вместо деления массива пополам ищем уже упорядоченные куски ("серии"):
+// неубывающие оставляем как есть, строго убывающие разворачиваем (строгость нужна для устойчивости).
+// Короткие серии дополняем до minrun сортировкой вставками с бинарным поиском.
+// Серии кладём в стек и сливаем так, чтобы длины в стеке росли хотя бы как числа Фибоначчи.
+// Если при слиянии одна серия выигрывает много раз подряд - переходим в режим галопа
+// (экспоненциальный поиск), копируя сразу целые куски.
+// На почти отсортированных данных время получается близким к O(n).
+// Описание: http://svn.python.org/projects/python/trunk/Objects/listsort.txt
+#include <iostream>
+#include <vector>
+#include <utility>
+
+// Серии короче этого сливаются без попытки галопа
+#define MIN_GALLOP 7
+// Массивы меньше этого размера сортируем вставками целиком
+#define MIN_MERGE 64
+
+// Сколько элементов a[0..n) не больше key (позиция вставки key справа от равных)
+template<typename T>
+int GallopRight(const T &key, const T *a, int n) {
+	// Экспоненциально ищем интервал (last, ofs], в котором находится ответ
+	int last = 0;
+	int ofs = 1;
+	while (ofs < n && !(key < a[ofs - 1])) {
+		last = ofs;
+		ofs = (ofs << 1) + 1;
+	}
+	if (ofs > n) {
+		ofs = n;
+	}
+	// Бинарный поиск внутри интервала
+	while (last < ofs) {
+		int mid = last + (ofs - last) / 2;
+		if (!(key < a[mid])) {
+			last = mid + 1;
+		} else {
+			ofs = mid;
+		}
+	}
+	return last;
+}
+
+// Сколько элементов a[0..n) строго меньше key (позиция вставки key слева от равных)
+template<typename T>
+int GallopLeft(const T &key, const T *a, int n) {
+	int last = 0;
+	int ofs = 1;
+	while (ofs < n && a[ofs - 1] < key) {
+		last = ofs;
+		ofs = (ofs << 1) + 1;
+	}
+	if (ofs > n) {
+		ofs = n;
+	}
+	while (last < ofs) {
+		int mid = last + (ofs - last) / 2;
+		if (a[mid] < key) {
+			last = mid + 1;
+		} else {
+			ofs = mid;
+		}
+	}
+	return last;
+}
+
+// Минимальная длина серии: от 32 до 64, чтобы n / minrun было чуть меньше степени двойки
+inline int MinRun(int n) {
+	int r = 0; // Станет 1, если среди сдвинутых битов была единица
+	while (n >= MIN_MERGE) {
+		r |= n & 1;
+		n >>= 1;
+	}
+	return n + r;
+}
+
+// Длина серии, начинающейся с v[lo]; убывающая серия разворачивается
+template<typename T>
+int CountRun(T *v, int lo, int hi) {
+	int i = lo + 1;
+	if (i == hi) {
+		return 1;
+	}
+	if (v[i] < v[lo]) {
+		// Строго убывающая серия
+		while (i + 1 < hi && v[i + 1] < v[i]) {
+			i++;
+		}
+		// Разворачиваем
+		for (int l = lo, r = i; l < r; l++, r--) {
+			std::swap(v[l], v[r]);
+		}
+	} else {
+		// Неубывающая серия
+		while (i + 1 < hi && !(v[i + 1] < v[i])) {
+			i++;
+		}
+	}
+	return i + 1 - lo;
+}
+
+// Сортировка вставками v[lo..hi), где v[lo..start) уже отсортирована
+template<typename T>
+void BinaryInsertionSort(T *v, int lo, int hi, int start) {
+	for (int i = start; i < hi; i++) {
+		T key = std::move(v[i]);
+		// Место вставки справа от равных - сохраняем устойчивость
+		int pos = lo + GallopRight(key, v + lo, i - lo);
+		for (int j = i; j > pos; j--) {
+			v[j] = std::move(v[j - 1]);
+		}
+		v[pos] = std::move(key);
+	}
+}
+
+// Слить соседние серии a[0..n1) и b = a + n1, b[0..n2). Левая серия переносится в tmp.
+template<typename T>
+void MergeLo(T *a, int n1, T *b, int n2, std::vector<T> &tmp) {
+	if ((int)tmp.size() < n1) {
+		tmp.resize(n1);
+	}
+	for (int i = 0; i < n1; i++) {
+		tmp[i] = std::move(a[i]);
+	}
+
+	T *l = &tmp[0];
+	T *lEnd = l + n1;
+	T *r = b;
+	T *rEnd = b + n2;
+	T *out = a; // Никогда не обгоняет r, поэтому правую серию не затираем
+	int winsL = 0; // Сколько раз подряд выигрывала левая серия
+	int winsR = 0; // ... и правая
+	while (l < lEnd && r < rEnd) {
+		if (*r < *l) {
+			*out++ = std::move(*r++);
+			winsR++;
+			winsL = 0;
+		} else {
+			*out++ = std::move(*l++);
+			winsL++;
+			winsR = 0;
+		}
+
+		// Одна из серий стабильно выигрывает - галоп
+		if (winsL >= MIN_GALLOP || winsR >= MIN_GALLOP) {
+			while (l < lEnd && r < rEnd) {
+				// Все элементы левой серии, не большие *r, идут подряд
+				int k1 = GallopRight(*r, l, (int)(lEnd - l));
+				for (int i = 0; i < k1; i++) {
+					*out++ = std::move(*l++);
+				}
+				if (l == lEnd) {
+					break;
+				}
+				// Все элементы правой серии, строго меньшие *l, идут подряд
+				int k2 = GallopLeft(*l, r, (int)(rEnd - r));
+				for (int i = 0; i < k2; i++) {
+					*out++ = std::move(*r++);
+				}
+				// Галоп перестал окупаться - возвращаемся к поэлементному слиянию
+				if (k1 < MIN_GALLOP && k2 < MIN_GALLOP) {
+					break;
+				}
+			}
+			winsL = 0;
+			winsR = 0;
+		}
+	}
+
+	// Остаток правой серии уже стоит на своём месте, дописываем остаток левой
+	while (l < lEnd) {
+		*out++ = std::move(*l++);
+	}
+}
+
+// Слить серии номер i и i + 1 из стека
+template<typename T>
+void MergeAt(T *v, std::vector<int> &base, std::vector<int> &len, int i, std::vector<T> &tmp) {
+	T *a = v + base[i];
+	int n1 = len[i];
+	T *b = v + base[i + 1];
+	int n2 = len[i + 1];
+
+	len[i] = n1 + n2;
+	base.erase(base.begin() + i + 1);
+	len.erase(len.begin() + i + 1);
+
+	// Начало левой серии, не большее b[0], уже на месте
+	int k = GallopRight(b[0], a, n1);
+	a += k;
+	n1 -= k;
+	if (n1 == 0) {
+		return;
+	}
+	// Конец правой серии, не меньший последнего элемента левой, тоже на месте
+	n2 = GallopLeft(a[n1 - 1], b, n2);
+	if (n2 == 0) {
+		return;
+	}
+	MergeLo(a, n1, b, n2, tmp);
+}
+
+template<typename T> void NaturalSort(std::vector<T> &v) {
+	int n = (int)v.size();
+	if (n <= 1) {
+		return;
+	}
+	T *p = &v[0];
+
+	// Маленький массив - одна серия, дополненная вставками
+	if (n < MIN_MERGE) {
+		BinaryInsertionSort(p, 0, n, CountRun(p, 0, n));
+		return;
+	}
+
+	int minRun = MinRun(n);
+	std::vector<int> base; // Стек серий: начало ...
+	std::vector<int> len; // ... и длина
+	std::vector<T> tmp;
+
+	int lo = 0;
+	while (lo < n) {
+		int run = CountRun(p, lo, n);
+		// Короткую серию дополняем до minRun
+		if (run < minRun) {
+			int force = (n - lo < minRun) ? n - lo : minRun;
+			BinaryInsertionSort(p, lo, lo + force, lo + run);
+			run = force;
+		}
+		base.push_back(lo);
+		len.push_back(run);
+		lo += run;
+
+		// Восстанавливаем инварианты стека:
+		// len[i - 2] > len[i - 1] + len[i] и len[i - 1] > len[i]
+		while (len.size() > 1) {
+			int i = (int)len.size() - 2;
+			if ((i > 0 && len[i - 1] <= len[i] + len[i + 1])
+					|| (i > 1 && len[i - 2] <= len[i - 1] + len[i])) {
+				if (len[i - 1] < len[i + 1]) {
+					i--;
+				}
+				MergeAt(p, base, len, i, tmp);
+			} else if (len[i] <= len[i + 1]) {
+				MergeAt(p, base, len, i, tmp);
+			} else {
+				break;
+			}
+		}
+	}
+
+	// Сливаем всё, что осталось в стеке, начиная с вершины
+	while (len.size() > 1) {
+		int i = (int)len.size() - 2;
+		if (i > 0 && len[i - 1] < len[i + 1]) {
+			i--;
+		}
+		MergeAt(p, base, len, i, tmp);
+	}
+}
+
+
+// Раскомментировать для теста сортировки
+/*
+int main()
+{
+	// comment this line for reading from stdin
+	freopen("numbers.txt", "r", stdin);
+
+	std::vector<int> v;
+
+	// read numbers until end-of-file
+	while( !std::cin.eof() ) {
+		int i = 0;
+		std::cin >> i;
+		v.push_back(i);
+	}
+
+	NaturalSort<int>(v);
+
+	// print an array
+	for(std::vector<int>::iterator it = v.begin(); it != v.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+}
+*/
@@ -0,0 +1,8 @@
+#ifndef NATURAL_MERGE_SORT_INCLUDED
+#define NATURAL_MERGE_SORT_INCLUDED
+
+#include "natural_merge_sort.cpp"
+
+template<typename T> void NaturalSort(std::vector<T> &v);
+
+#endif
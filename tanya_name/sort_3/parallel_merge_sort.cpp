@@ -0,0 +1,211 @@
+// Параллельная устойчивая сортировка слиянием
+// Листья (куски массива по числу потоков) сортируются параллельно.
+// Затем на каждом уровне слияния каждая пара кусков делится на равные части результата
+// с помощью co-rank (бинарный поиск позиции разреза в обоих кусках), и каждый поток
+// сливает свою часть - так все ядра участвуют в каждом уровне, включая последний.
+// Алгоритм co-rank: http://arxiv.org/abs/1202.6575 (Siebert, Träff - Perfectly load-balanced, optimal, stable, parallel merge)
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <utility>
+#include <stdint.h>
+
+// Меньше этого количества элементов не стоит запускать потоки
+#define PARALLEL_MIN_SIZE (64 * 1024)
+// Куски меньше этого размера сортируем вставками
+#define INSERTION_SORT_SIZE 16
+
+// Запустить f(0) .. f(p - 1) в p потоках и дождаться их завершения
+template<typename F> void RunThreads(int p, F f) {
+	std::vector<std::thread> threads;
+	threads.reserve(p);
+	for (int t = 1; t < p; t++) {
+		threads.push_back(std::thread(f, t));
+	}
+	f(0); // Нулевую часть делаем в текущем потоке
+	for (int t = 0; t < (int)threads.size(); t++) {
+		threads[t].join();
+	}
+}
+
+// Устойчиво слить a[0..n) и b[0..m) в out. При равенстве первым идёт элемент из a.
+// Элементы перемещаются из a и b (без копирования строк и т.п.).
+template<typename T>
+void MergeRange(T *a, int n, T *b, int m, T *out) {
+	int i = 0;
+	int j = 0;
+	while (i < n && j < m) {
+		if (b[j] < a[i]) {
+			*out++ = std::move(b[j++]);
+		} else {
+			*out++ = std::move(a[i++]);
+		}
+	}
+	// Один из кусков уже пуст - отработает лишь один из циклов
+	for (; i < n; i++) {
+		*out++ = std::move(a[i]);
+	}
+	for (; j < m; j++) {
+		*out++ = std::move(b[j]);
+	}
+}
+
+// Co-rank: сколько элементов из a попадёт в первые k элементов устойчивого слияния a и b.
+// Остальные k - i элементов берутся из b.
+template<typename T>
+int CoRank(int k, const T *a, int n, const T *b, int m) {
+	int lo = (k - m > 0) ? k - m : 0;
+	int hi = (k < n) ? k : n;
+	// Ищем первое i, при котором a[i] уже не входит в первые k (a[i] строго больше b[k - i - 1])
+	while (lo < hi) {
+		int i = lo + (hi - lo) / 2;
+		if (!(b[k - i - 1] < a[i])) {
+			lo = i + 1; // a[i] идёт раньше b[k - i - 1] - берём больше из a
+		} else {
+			hi = i;
+		}
+	}
+	return lo;
+}
+
+// Последовательная сортировка слиянием куска v[0..n) с буфером buf того же размера
+template<typename T>
+void SortRange(T *v, T *buf, int n) {
+	if (n <= INSERTION_SORT_SIZE) {
+		// Сортировка вставками для маленьких кусков (устойчивая)
+		for (int i = 1; i < n; i++) {
+			T key = std::move(v[i]);
+			int j = i - 1;
+			while (j >= 0 && key < v[j]) {
+				v[j + 1] = std::move(v[j]);
+				--j;
+			}
+			v[j + 1] = std::move(key);
+		}
+		return;
+	}
+
+	int mid = n / 2;
+	SortRange(v, buf, mid);
+	SortRange(v + mid, buf + mid, n - mid);
+	// Половины уже упорядочены друг относительно друга - сливать не надо
+	if (!(v[mid] < v[mid - 1])) {
+		return;
+	}
+	MergeRange(v, mid, v + mid, n - mid, buf);
+	for (int i = 0; i < n; i++) {
+		v[i] = std::move(buf[i]);
+	}
+}
+
+// threads == 0 - по числу ядер
+template<typename T> void ParallelSort(std::vector<T> &v, int threads = 0) {
+	int n = (int)v.size();
+	int p = threads > 0 ? threads : (int)std::thread::hardware_concurrency();
+	if (p < 1) {
+		p = 1;
+	}
+
+	std::vector<T> buf(v.size());
+	// Мало элементов или одно ядро - сортируем последовательно
+	if (p == 1 || n < PARALLEL_MIN_SIZE) {
+		if (n > 1) {
+			SortRange(&v[0], &buf[0], n);
+		}
+		return;
+	}
+
+	// Границы отсортированных кусков: кусок r - это [bounds[r], bounds[r + 1])
+	std::vector<int> bounds(p + 1);
+	for (int r = 0; r <= p; r++) {
+		bounds[r] = (int)((int64_t)n * r / p);
+	}
+
+	// Листья - каждый поток сортирует свой кусок
+	RunThreads(p, [&](int t) {
+		SortRange(&v[bounds[t]], &buf[bounds[t]], bounds[t + 1] - bounds[t]);
+	});
+
+	// Уровни слияния: сливаем соседние пары кусков из src в dst, потом меняем их местами
+	std::vector<T> *src = &v;
+	std::vector<T> *dst = &buf;
+	while (bounds.size() > 2) {
+		int runs = (int)bounds.size() - 1;
+		T *s = &(*src)[0];
+		T *d = &(*dst)[0];
+
+		// Разрезы считаем заранее, до слияния: слияние перемещает элементы, и co-rank
+		// одного потока не должен читать элементы, уже перемещённые другим потоком.
+		// cut[(r / 2) * (p + 1) + t] - сколько элементов из левого куска пары r
+		// попадает в первые len * t / p элементов результата.
+		std::vector<int> cut((runs + 1) / 2 * (p + 1));
+		for (int r = 0; r < runs; r += 2) {
+			int lo = bounds[r];
+			int mid = bounds[r + 1];
+			int hi = (r + 2 <= runs) ? bounds[r + 2] : mid; // Нечётный последний кусок - без пары
+			for (int t = 0; t <= p; t++) {
+				int k = (int)((int64_t)(hi - lo) * t / p);
+				cut[(r / 2) * (p + 1) + t] = CoRank(k, s + lo, mid - lo, s + mid, hi - mid);
+			}
+		}
+
+		RunThreads(p, [&](int t) {
+			for (int r = 0; r < runs; r += 2) {
+				int lo = bounds[r];
+				int mid = bounds[r + 1];
+				int hi = (r + 2 <= runs) ? bounds[r + 2] : mid;
+				// Поток t сливает часть [from, to) результата этой пары
+				int len = hi - lo;
+				int from = (int)((int64_t)len * t / p);
+				int to = (int)((int64_t)len * (t + 1) / p);
+				int i1 = cut[(r / 2) * (p + 1) + t];
+				int i2 = cut[(r / 2) * (p + 1) + t + 1];
+				MergeRange(s + lo + i1, i2 - i1, s + mid + (from - i1), (to - i2) - (from - i1), d + lo + from);
+			}
+		});
+
+		// Новые границы - каждая вторая из старых (и последняя)
+		std::vector<int> next;
+		for (int r = 0; r < runs; r += 2) {
+			next.push_back(bounds[r]);
+		}
+		next.push_back(n);
+		bounds.swap(next);
+
+		std::vector<T> *temp = src;
+		src = dst;
+		dst = temp;
+	}
+
+	// Результат оказался в буфере - меняем содержимое векторов за константное время
+	if (src != &v) {
+		v.swap(buf);
+	}
+}
+
+
+// Раскомментировать для теста сортировки
+/*
+int main()
+{
+	// comment this line for reading from stdin
+	freopen("numbers.txt", "r", stdin);
+
+	std::vector<int> v;
+
+	// read numbers until end-of-file
+	while( !std::cin.eof() ) {
+		int i = 0;
+		std::cin >> i;
+		v.push_back(i);
+	}
+
+	ParallelSort<int>(v);
+
+	// print an array
+	for(std::vector<int>::iterator it = v.begin(); it != v.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+}
+*/
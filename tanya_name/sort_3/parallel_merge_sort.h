@@ -0,0 +1,8 @@
+#ifndef PARALLEL_MERGE_SORT_INCLUDED
+#define PARALLEL_MERGE_SORT_INCLUDED
+
+#include "parallel_merge_sort.cpp"
+
+template<typename T> void ParallelSort(std::vector<T> &v, int threads);
+
+#endif
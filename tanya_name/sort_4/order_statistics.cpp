@@ -3,6 +3,8 @@
 #include <vector>
 #include <stdlib.h> // rand()
 
+#include "../common/fast_input.h"
+
 // Partition куска массива с from по to (включая) с выбором случайного опорного элемента
 // Возвращаем финальный индекс опорного элемента
 int RandPart(std::vector<int> &v, int from, int to) {
@@ -72,16 +74,12 @@ int main()
 	// По условию до миллиарда - хватит знакового целого
 	std::vector<int> v;
 	
+	FastInput in;
 	int n = 0;
-	std::cin >> n;
+	in.Read(n);
 	int order = 0;
-	std::cin >> order;
-	while (!std::cin.eof() && n > 0) {
-		--n;
-		int i = 0;
-		std::cin >> i;
-		v.push_back(i);
-	}
+	in.Read(order);
+	in.Read(v, n);
 	
 	// Для теста - вывести все введённые данные.
 	/*
@@ -3,6 +3,9 @@
 #include <vector>
 
 #include "merge_sort.h"
+#include "../common/simd_merge.h"
+#include "../common/loser_tree.h"
+#include "../common/fast_input.h"
 
 // По условию, все n чисел могут не помещаться в память, мы будем читать только 
 // k из них за раз, и дополнительно хранить только k минимальных. (Это k + k ячеек памяти)
@@ -20,6 +23,13 @@
 //
 // В итоге, данный алгоритм удовлетворяет требованиям задания по использованию
 // оперативной памяти и процессорного времени. (И использует слияния)
+//
+// Чтобы k минимальных не копировались заново после каждой группы, читаем сразу
+// RUNS_PER_MERGE групп по k, сортируем каждую и сливаем их вместе с k минимальными
+// деревом проигравших за один проход. Памяти по-прежнему O(k) - (RUNS_PER_MERGE + 2) * k.
+
+// Сколько групп по k элементов сливать за раз
+#define RUNS_PER_MERGE 8
 
 
 // Слить два отсортированных списка в один список из k минимальных элементов.
@@ -36,51 +46,27 @@ void Merge(std::vector<int> &a, std::vector<int> &b, int k) {
 		return;
 	}
 	
-	std::vector<int> r; // для хранения результата из k минимальных элементов
-	r.reserve(k); // Сразу говорим, что ожидается не меньше k элементов.
+	// для хранения результата из k минимальных элементов
+	std::vector<int> r((n + m < k) ? n + m : k);
 	
-	int i = 0; // Итератор для a
-	int j = 0; // Итератор для b
-	while(i < n && j < m && i + j < k) {
-		if (a[i] < b[j]) {
-			r.push_back(a[i]);
-			++i;
-		} else {
-			r.push_back(b[j]);
-			++j;
-		}
-	}
-	// Дозаполняем результат из оставшегося списка
-	for (; i + j < k && i < n; ++i) {
-		r.push_back(a[i]);
-	}
-	for (; i + j < k && j < m; ++j) {
-		r.push_back(b[j]);
-	}
+	// Векторное слияние, останавливается после k элементов
+	MergeSorted(&a[0], n, &b[0], m, &r[0], (int)r.size());
 	
 	// Возвращаем результат в первом параметре функции
 	a.swap(r); // Меняет содержимое 2 векторов за константное время http://www.cplusplus.com/reference/vector/vector/swap/
 }
 
 
-// Считать максимум k чисел из оставшихся n из входного потока данных stream
-void ReadK(std::vector<int> &v, int n, int k, std::istream& stream) {
+// Считать максимум k чисел из оставшихся n со входа in
+void ReadK(std::vector<int> &v, int n, int k, FastInput &in) {
 	v.clear(); // Очищаем куда будем читать
 	
 	// Нечего читать - выходим
-	if (n <= 0 || stream.eof()) return;
+	if (n <= 0) return;
 	
-	v.reserve(k); // Если входные данные будут достаточно длинными, то в подавляющем
-				// большинстве случаев мы считаем не меньше k элементов.
-
-	// Должны считать минимум из (k, n) чисел
+	// Должны считать минимум из (k, n) чисел, память под них выделяется сразу
 	int min = (k < n) ? k : n;
-	while (!stream.eof() && min > 0) {
-		--min;
-		int i = 0;
-		stream >> i;
-		v.push_back(i);
-	}
+	in.Read(v, min);
 }
 
 
@@ -90,21 +76,34 @@ int main()
 	freopen("test.txt", "r", stdin);
 	
 	
+	FastInput in;
 	int n = 0;
-	std::cin >> n;
+	in.Read(n);
 	int k = 0;
-	std::cin >> k;
+	in.Read(k);
 
 	std::vector<int> v;
-	std::vector<int> buf;
-	// Читаем по k элементов, сортируем, сливаем с существующими k минимальными
-	while (!std::cin.eof() && n > 0) {
-		ReadK(buf, n, k, std::cin);
-		n -= (int)buf.size();
+	// runs[0] - текущие k минимальных, остальные - прочитанные группы
+	std::vector<std::vector<int> > runs(1);
+	// Читаем группы по k элементов, сортируем, сливаем с существующими k минимальными
+	while (!in.Eof() && n > 0) {
+		runs.resize(1);
+		while (!in.Eof() && n > 0 && (int)runs.size() <= RUNS_PER_MERGE) {
+			runs.push_back(std::vector<int>());
+			ReadK(runs.back(), n, k, in);
+			n -= (int)runs.back().size();
+			Sort(runs.back());
+		}
 		
-		Sort(buf);
-		Merge(v, buf, k);
+		if (runs.size() == 2) {
+			// Одна группа - обычное слияние двух списков
+			Merge(runs[0], runs[1], k);
+		} else {
+			MergeRuns(runs, k, v);
+			runs[0].swap(v);
+		}
 	}
+	v.swap(runs[0]);
 	
 	// Вывести первые k чисел в отсортированном порядке
 	for (std::vector<int>::iterator it = v.begin(); it != v.end(); ++it) {
@@ -6,31 +6,20 @@
 #include <vector>
 #include <stdint.h>
 
-// Биты считаются от 0 до 63 начиная со старшего
-int inline GetBit(int64_t i, int digit) {
-	return (i >> (64 - (digit + 1))) & 1;
-}
+#include "../common/external_sort.h"
+#include "binary_sort.h"
+#include "../common/fast_input.h"
+#include "../common/packed_array.h"
+#include "../common/parallel_writer.h"
 
-// Сортирует массив от элемента 'from' до 'to' по 'bit' биту
-void Partition(std::vector<int64_t> &v, int from, int to, int bit) {
-	// Тривиальный случай - один элемент в массиве или bit >= 64
-	if (bit >= 64 || to <= from) return;
-	
-	int i = from; // Итератор конца нулей
-	for (int j = from; j <= to; j ++) {
-		if (GetBit(v[j], bit) == 0) {
-			// Меняем v[i] и v[j], прибавляем i
-			int64_t temp = v[j];
-			v[j] = v[i];
-			v[i] = temp;
-			++i;
-		}
-	}
-	
-	// Рекурсивно сортируем часть массива с 0 и с 1
-	Partition(v, from, i - 1, bit + 1);
-	Partition(v, i, to, bit + 1);
-}
+// Раскомментировать для внешней сортировки входа, не помещающегося в память.
+// Значение - сколько байт памяти разрешено занять под данные.
+//#define EXTERNAL_SORT_BUDGET ((size_t)1024 * 1024 * 1024)
+
+// Раскомментировать, чтобы записать весь отсортированный массив в этот файл в сжатом
+// виде (common/packed_array.cpp) вместо вывода всех чисел текстом (только при сортировке
+// в памяти)
+//#define PACKED_OUTPUT "sorted.pk"
 
 void Sort(std::vector<int64_t> &v) {
 	Partition(v, 0, (int)v.size() - 1, 0);
@@ -42,17 +31,31 @@ int main()
 	// Закомментировать строку для чтения с stdin
 	freopen("numbers.txt", "r", stdin);
 	
-	// 64 битные числа
-	std::vector<int64_t> v;
-	
 	// количество - до миллиона
+	FastInput in;
+	// Сжатый файл (например, свой же PACKED_OUTPUT) - уже отсортированные числа без количества
+	bool presorted = in.Sorted();
 	int n = 0;
-	std::cin >> n;
-	while (!std::cin.eof() && n > 0) {
-		--n;
-		int64_t i = 0;
-		std::cin >> i;
-		v.push_back(i);
+	if (!presorted) {
+		in.Read(n);
+	}
+	
+#ifdef EXTERNAL_SORT_BUDGET
+	bool sorted = ExternalSort<int64_t>(
+		[&n, &in, presorted](int64_t &x) { return (presorted || n-- > 0) && in.Read(x); },
+		[](const int64_t &x) { std::cout << x << " "; },
+		EXTERNAL_SORT_BUDGET,
+		[](std::vector<int64_t> &v) { Sort(v); });
+	std::cout << std::endl;
+	return sorted ? 0 : 1;
+#endif
+	
+	// 64 битные числа
+	std::vector<int64_t> v;
+	if (presorted) {
+		in.ReadAll(v);
+	} else {
+		in.Read(v, n);
 	}
 	
 	// Для теста - вывести все введённые данные.
@@ -63,7 +66,9 @@ int main()
 	std::cout << std::endl;
 	*/
 	
-	Sort(v);
+	if (!presorted) {
+		Sort(v);
+	}
 	
 	// Контрольная отладка
 	// for (int i = 1; i < n; i++) {
@@ -72,9 +77,14 @@ int main()
 		// }
 	// }
 	
-	// Вывести отсортированные данные
-	for (std::vector<int64_t>::iterator it = v.begin(); it != v.end(); ++it) {
-		std::cout << *it << " ";
+#ifdef PACKED_OUTPUT
+	if (!WritePackedFile(PACKED_OUTPUT, v)) {
+		std::cerr << "Ошибка записи " << PACKED_OUTPUT << std::endl;
 	}
-	std::cout << std::endl;
+	return 0;
+#endif
+
+	// Вывести отсортированные данные (куски переводятся в текст параллельно)
+	WriteNumbers(1, v);
+	WriteAll(1, "\n", 1);
 }
\ No newline at end of file
@@ -0,0 +1,33 @@
+// Бинарный QuickSort (поразрядная MSD сортировка по одному биту)
+// Алгоритм: http://www.cs.princeton.edu/courses/archive/spr02/cs226/lectures/radix.4up.pdf
+// Принцип обычного quicksort, только мы разделяем массив каждый раз n-му биту элементов
+// (вынесен из binary_quicksort.cpp, чтобы использовать его и в других программах)
+// Отрицательные числа (старший бит 1) встают после неотрицательных.
+#include <vector>
+#include <utility>
+
+// Биты считаются от 0 до (число бит T - 1) начиная со старшего
+template<typename T>
+int inline GetBit(T i, int digit) {
+	return (int)((i >> (sizeof(T) * 8 - (digit + 1))) & 1);
+}
+
+// Сортирует массив от элемента 'from' до 'to' по 'bit' биту
+template<typename T>
+void Partition(std::vector<T> &v, int from, int to, int bit) {
+	// Тривиальный случай - один элемент в массиве или биты кончились
+	if (bit >= (int)sizeof(T) * 8 || to <= from) return;
+	
+	int i = from; // Итератор конца нулей
+	for (int j = from; j <= to; j ++) {
+		if (GetBit(v[j], bit) == 0) {
+			// Меняем v[i] и v[j], прибавляем i
+			std::swap(v[i], v[j]);
+			++i;
+		}
+	}
+	
+	// Рекурсивно сортируем часть массива с 0 и с 1
+	Partition(v, from, i - 1, bit + 1);
+	Partition(v, i, to, bit + 1);
+}
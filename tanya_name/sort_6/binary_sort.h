@@ -0,0 +1,8 @@
+#ifndef BINARY_SORT_INCLUDED
+#define BINARY_SORT_INCLUDED
+
+#include "binary_sort.cpp"
+
+template<typename T> void Partition(std::vector<T> &v, int from, int to, int bit);
+
+#endif
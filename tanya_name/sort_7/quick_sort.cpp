@@ -0,0 +1,171 @@
+// Быстрая сортировка с выбором опорного элемента медианой трёх,
+// сортирующими сетями для кусков до 6 элементов и без хвостовой рекурсии
+// (вынесена из quickest_sort.cpp, чтобы использовать её и в других программах)
+#include <vector>
+#include <utility>
+#include <functional>
+
+#include "../common/heap_sift.h"
+
+// Оптимизация для сортировки малого количества элементов
+// http://stackoverflow.com/questions/2786899/fastest-sort-of-fixed-length-6-int-array
+// Генератор сравнений http://pages.ripco.net/~jgamble/nw.html
+
+// Сколько элементов сортируем "вручную"
+#define MIN_LIST_SIZE 6
+
+// Упорядочить пару. Для int - min/max без переходов (условные пересылки),
+// для остальных типов - обмен перемещением, без копирования
+template<typename T> inline void CompareSwap(T &x, T &y) {
+	if (y < x) {
+		std::swap(x, y);
+	}
+}
+inline void CompareSwap(int &x, int &y) {
+	const int a = x < y ? x : y;
+	const int b = x < y ? y : x;
+	x = a;
+	y = b;
+}
+
+#define SWAP(x,y) CompareSwap(d[x], d[y]);
+template<typename T> static inline void sort6(T * d) {
+	SWAP(1, 2);
+    SWAP(4, 5);
+    SWAP(0, 2);
+    SWAP(3, 5);
+    SWAP(0, 1);
+    SWAP(3, 4);
+    SWAP(2, 5);
+    SWAP(1, 4);
+    SWAP(0, 3);
+    SWAP(2, 4);
+    SWAP(1, 3);
+    SWAP(2, 3);
+}
+template<typename T> static inline void sort5(T * d) {
+	SWAP(3, 4);
+	SWAP(0, 1);
+	SWAP(2, 4);
+	SWAP(2, 3);
+	SWAP(1, 4);
+	SWAP(0, 3);
+	SWAP(0, 2)
+	SWAP(1, 3);
+	SWAP(1, 2);
+}
+template<typename T> static inline void sort4(T * d) {
+	SWAP(0, 1);
+	SWAP(2, 3);
+	SWAP(0, 2);
+	SWAP(1, 3);
+	SWAP(1, 2);
+}
+template<typename T> static inline void sort3(T * d) {
+	SWAP(1, 2);
+	SWAP(0, 2);
+	SWAP(0, 1);
+}
+template<typename T> static inline void sort2(T * d) {
+	SWAP(0, 1);
+}
+#undef SWAP
+
+// Быстрая сортировка с оптимизацией выбора опорного элемента (и хвостовой рекурсии)
+// http://www.cs.utexas.edu/users/lavender/courses/EE360C/lectures/lecture-22.pdf
+// (там на слайдах в коде ошибка в строке "int i = low, j = high;" (должно быть high - 1)
+
+// depth - предел глубины разбиений (интроспективная сортировка, Musser 1997):
+// когда он исчерпан, кусок досортировывается пирамидальной сортировкой (common/heap_sift.cpp),
+// и на плохом для медианы трёх входе время остаётся O(n log n). depth < 0 - без предела.
+// http://en.wikipedia.org/wiki/Introsort
+template<class T>
+void quickSort (std::vector<T> &v, int low, int high, int depth = -1) {
+	// Элементы только обмениваются (std::swap перемещает), копий не создаётся
+	do {
+		if (low >= high) return; // Тривиальный случай - один элемент
+		
+		if (low + MIN_LIST_SIZE > high) {
+			// Оптимизация для сортировки малых кусков массива
+			T * d = &v[low];
+			switch (high - low + 1) {
+				case 2: sort2(d); break;
+				case 3: sort3(d); break;
+				case 4: sort4(d); break;
+				case 5: sort5(d); break;
+				case 6: sort6(d); break;
+			}
+			
+			// Отладка
+			// for (int i = low + 1; i <= high; ++i) {
+				// if (v[i - 1] > v[i]) {
+					// std::cout << v[i - 1] << " " << v[i] << " " << high - low + 1 << std::endl;
+				// }
+			// }
+			
+			return;
+		}
+		
+		if (depth == 0) {
+			// Слишком много неудачных разбиений - вход плохой для медианы трёх
+			HeapSort(&v[low], (size_t)(high - low + 1), std::less<T>());
+			return;
+		}
+		depth -= (depth > 0);
+		
+		int mid = (low + high) / 2;
+		if (v[high] < v[mid]) std::swap(v[mid], v[high]);
+		if (v[high] < v[low]) std::swap(v[low], v[high]);
+		if (v[mid] < v[low]) std::swap(v[low], v[mid]);
+		
+		// Отладка
+		// if (v[low] > v[mid] || v[mid] > v[high]) {
+			// std::cout << v[low] << " " << v[mid] << " " << v[high] << std::endl;
+		// }
+		
+		std::swap(v[mid], v[high - 1]); // вставляем опорный элемент прямо перед a[high]
+		// Ссылка, а не копия: a[high - 1] не трогается до конца разбиения
+		// (i останавливается на нём, j и обмены его не достают)
+		const T &pivot = v[high - 1];
+		int i = low, j = high - 1;
+		while (true) {
+			while (v[++i] < pivot) {;} // сканируем вправо, пока не a[i] >= pivot
+			while (pivot < v[--j]) {;} // сканируем влево, пока не a[j] <= pivot
+			if (i < j) {
+				std::swap(v[i], v[j]);
+			} else {
+				break;
+			}
+		}
+		std::swap(v[i], v[high - 1]); // восстанавливаем позицию опорного элемента
+		
+		// Отладка
+		// if (v[low] > v[i] || v[i] > v[high]) {
+			// std::cout << v[low] << " " << v[mid] << " " << v[high] << std::endl;
+		// }
+		
+		// Оптимизация хвостовой рекурсии для сортировки правой части массива: 
+		// задание новых значений low и high
+		// Делаем оптимизацию хвостового вызова для бОльшей части массива
+		if ((i - 1) - low < high - (i + 1)) {
+			quickSort(v, low, i - 1, depth); // Рекурсивная ортировка левой части массива
+			low = i + 1; // Задание low для хвостовой рекурсии
+		} else {
+			quickSort(v, i + 1, high, depth); // Рекурсивная сортировка правой части массива
+			high = i - 1; // Задание high для хвостовой рекурсии
+		}
+	} while (true); // Возврат из функции будет, когда дойдём до размера <= 6
+}
+
+/* call qsort to start the sort */
+template<class T> inline void Sort (std::vector<T> &v) { 
+	quickSort(v, 0, (int)v.size() - 1); 
+	
+	// Контрольная отладка
+	// int n = (int)v.size();
+	// for (int i = 1; i < n; i++) {
+		// if (v[i - 1] > v[i]) {
+			// std::cout << v[i - 1] << " " << v[i] << std::endl;
+		// }
+	// }
+}
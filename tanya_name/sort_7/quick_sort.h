@@ -0,0 +1,8 @@
+#ifndef QUICK_SORT_INCLUDED
+#define QUICK_SORT_INCLUDED
+
+#include "quick_sort.cpp"
+
+template<class T> inline void Sort (std::vector<T> &v);
+
+#endif
@@ -0,0 +1,116 @@
+// Перевод входных данных между текстом, двоичным форматом (common/binary_array.cpp)
+// и сжатым форматом отсортированных чисел (common/packed_array.cpp)
+// Текст разбирается один раз, дальше программы читают двоичный файл без разбора:
+// достаточно подставить его вместо текстового во freopen.
+//
+// Запуск: binary_convert input output [int32|int64|packed32|packed64|text]
+//   input - текстовый, двоичный или сжатый файл (формат определяется по заголовку)
+//   int32, int64 - записать двоичный файл с элементами этого типа (по умолчанию int32)
+//   packed32, packed64 - записать сжатый файл (вход должен быть отсортирован)
+//   text - записать числа текстом, по одному в строке
+// Компилировать с оптимизацией: g++ -O2 binary_convert.cpp
+#include <iostream>
+#include <string>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "../common/binary_array.h"
+#include "../common/packed_array.h"
+#include "../common/fast_input.h"
+
+// Записать числа текстом. false - ошибка записи.
+bool WriteText(FastInput &in, FILE *out, uint64_t &count) {
+	char line[24];
+	int64_t x;
+	while (in.Read(x)) {
+		// Цифры с конца строки
+		char *p = line + sizeof(line);
+		*--p = '\n';
+		uint64_t u = x < 0 ? 0 - (uint64_t)x : (uint64_t)x;
+		do {
+			*--p = (char)('0' + u % 10);
+			u /= 10;
+		} while (u != 0);
+		if (x < 0) {
+			*--p = '-';
+		}
+		size_t len = line + sizeof(line) - p;
+		if (fwrite(p, 1, len, out) != len) {
+			return false;
+		}
+		count++;
+	}
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc < 3) {
+		std::cerr << "Запуск: binary_convert input output [int32|int64|packed32|packed64|text]" << std::endl;
+		return 1;
+	}
+	std::string format = argc > 3 ? argv[3] : "int32";
+	bool pack = format == "packed32" || format == "packed64";
+	if (format != "int32" && format != "int64" && format != "text" && !pack) {
+		std::cerr << "Неизвестный формат " << format << std::endl;
+		return 1;
+	}
+
+	int fd = open(argv[1], O_RDONLY);
+	if (fd < 0) {
+		std::cerr << "Не открывается " << argv[1] << std::endl;
+		return 1;
+	}
+	FILE *out = fopen(argv[2], "wb");
+	if (out == NULL) {
+		std::cerr << "Не открывается " << argv[2] << std::endl;
+		return 1;
+	}
+
+	FastInput in(fd);
+	uint64_t count = 0;
+	bool ok = true;
+	bool sorted = false;
+	if (format == "text") {
+		ok = WriteText(in, out, count);
+	} else if (pack) {
+		PackedWriter writer(out, format == "packed32" ? BINARY_INT32 : BINARY_INT64);
+		int64_t x;
+		while (ok && in.Read(x)) {
+			ok = writer.Write(x);
+			if (!ok) {
+				std::cerr << "Число " << x << " номер " << writer.Count()
+					<< " меньше предыдущего или не помещается в " << format << std::endl;
+			}
+		}
+		count = writer.Count();
+		sorted = true;
+		ok = writer.Close() && ok;
+	} else {
+		BinaryWriter writer(out, format == "int32" ? BINARY_INT32 : BINARY_INT64);
+		int64_t x;
+		while (ok && in.Read(x)) {
+			ok = writer.Write(x);
+			if (!ok) {
+				std::cerr << "Число " << x << " не помещается в " << format << std::endl;
+			}
+		}
+		count = writer.Count();
+		sorted = writer.Sorted();
+		ok = writer.Close() && ok;
+	}
+	// Всё, что не разобралось как число, - ошибка (слова двоичный формат не хранит)
+	if (ok && !in.Eof()) {
+		std::cerr << "После " << count << " чисел во входе не число" << std::endl;
+		ok = false;
+	}
+	ok = fclose(out) == 0 && ok;
+	close(fd);
+	if (!ok) {
+		std::cerr << "Ошибка записи " << argv[2] << std::endl;
+		return 1;
+	}
+	std::cerr << count << " чисел" << (sorted ? ", упорядочены" : "") << std::endl;
+	return 0;
+}
@@ -0,0 +1,232 @@
+// Хеш-таблица строк с хранением ключей в общей памяти (арене)
+// В StringHashTable каждый слот - std::string (32 байта, даже пустой) и отдельное
+// выделение памяти для строк длиннее 15 символов. Здесь строки дописываются подряд
+// в арену из кусков по ARENA_CHUNK байт, а слот - 12 байт:
+//   offset - смещение строки в арене, length - длина строки,
+//   hash - старшие 32 бита хеша строки.
+// Слот пустой, если length == 0 (пустая строка - специальный случай), и удалённый,
+// если length == ARENA_DELETED (ленивое удаление).
+// Номер ячейки - старшие M бит хеша, поэтому хранимых 32 бит хватает для
+// перехеширования без пересчёта хеша. Строки сравниваются, только если совпали длины
+// и хранимые биты хеша.
+// Пробирование квадратичное: g(i) = g(i - 1) + i (mod capacity).
+// Перехеширование (с удвоением, если нужно) - когда заняты или удалены 3/4 слотов.
+// Удалённые строки остаются в арене; когда их суммарная длина превышает длину живых
+// строк, арена уплотняется: живые строки переписываются в новую подряд.
+// Всего в арене - не больше 4 ГБ строк (смещение 32-битное).
+#include <vector>
+#include <string>
+#include <utility>
+#include <string.h>
+#include <stdint.h>
+
+#include "string_hash.h"
+
+// Байт в куске арены (степень двойки)
+#define ARENA_CHUNK_BITS 20
+#define ARENA_CHUNK (1u << ARENA_CHUNK_BITS)
+// Длина в удалённом слоте
+#define ARENA_DELETED 0xFFFFFFFFu
+
+// Арена строк: смещение = номер куска * ARENA_CHUNK + место в куске.
+// Строка не пересекает границу куска; строке длиннее куска выделяется свой кусок
+// нужного размера, а следующие за ним номера кусков остаются пустыми.
+class StringArena {
+	std::vector<std::vector<char> > chunks;
+	uint32_t top; // смещение следующей строки
+
+public:
+	StringArena() : top(0) {}
+
+	// Дописать строку, вернуть её смещение
+	uint32_t Add(const char *s, uint32_t length) {
+		uint32_t pos = top & (ARENA_CHUNK - 1);
+		if (pos != 0 && pos + length > ARENA_CHUNK) {
+			// Не помещается в текущий кусок - остаток куска пропадает
+			top += ARENA_CHUNK - pos;
+			pos = 0;
+		}
+		if (pos == 0) {
+			// Новый кусок (для длинной строки - с запасом номеров на её длину)
+			uint32_t count = (length + ARENA_CHUNK - 1) >> ARENA_CHUNK_BITS;
+			chunks.resize((top >> ARENA_CHUNK_BITS) + (count > 1 ? count : 1));
+			chunks[top >> ARENA_CHUNK_BITS].resize(length > ARENA_CHUNK ? length : ARENA_CHUNK);
+		}
+		uint32_t offset = top;
+		memcpy(&chunks[offset >> ARENA_CHUNK_BITS][offset & (ARENA_CHUNK - 1)], s, length);
+		top += length;
+		// После длинной строки следующая начинается с нового куска
+		if (length > ARENA_CHUNK) {
+			top = (uint32_t)chunks.size() << ARENA_CHUNK_BITS;
+		}
+		return offset;
+	}
+
+	inline const char *Get(uint32_t offset) const {
+		return &chunks[offset >> ARENA_CHUNK_BITS][offset & (ARENA_CHUNK - 1)];
+	}
+
+	void swap(StringArena &other) {
+		chunks.swap(other.chunks);
+		std::swap(top, other.top);
+	}
+};
+
+class ArenaHashTable {
+// Начальная ёмкость таблицы. Должна быть степенью двойки.
+#define ARENA_INITIAL_CAPACITY 8
+
+	struct Slot {
+		uint32_t offset;
+		uint32_t length; // 0 - пустой слот, ARENA_DELETED - удалённый
+		uint32_t hash; // старшие 32 бита хеша
+	};
+
+	std::vector<Slot> slots;
+	StringArena arena;
+	unsigned int capacity; // ёмкость таблицы
+	unsigned int M; // lg(capacity)
+	unsigned int mask; // capacity - 1
+	unsigned int size; // заполненность таблицы
+	unsigned int used; // занятые и удалённые слоты
+	unsigned int limit; // Предел used (3/4 от capacity)
+	uint64_t liveBytes; // суммарная длина строк в таблице
+	uint64_t deadBytes; // суммарная длина удалённых строк, оставшихся в арене
+	uint64_t a, b, c; // параметры хеш-функции
+
+	bool containsEmpty; // Специальный случай - содержит ли таблица пустую строку
+
+	// Старшие 32 бита хеша строки
+	inline uint32_t Hash(const std::string &s) {
+		return (uint32_t)((a * WordHash(s, c) + b) >> 32);
+	}
+
+	// Номер ячейки - старшие M бит хеша
+	inline unsigned int Place(uint32_t hash) const {
+		return M == 0 ? 0 : (unsigned int)(hash >> (32 - M));
+	}
+
+	// Слот со строкой s или capacity, если её нет
+	unsigned int find_internal(const std::string &s, uint32_t hash) const {
+		uint32_t length = (uint32_t)s.size();
+		unsigned int place = Place(hash);
+		for (unsigned int i = 1; slots[place].length != 0; i++) {
+			const Slot &slot = slots[place];
+			if (slot.hash == hash && slot.length == length
+				&& memcmp(arena.Get(slot.offset), s.data(), length) == 0) {
+				return place;
+			}
+			place = (place + i) & mask;
+		}
+		return capacity;
+	}
+
+	// Вставка заведомо отсутствующей строки в первый пустой или удалённый слот
+	void Insert(uint32_t offset, uint32_t length, uint32_t hash) {
+		unsigned int place = Place(hash);
+		for (unsigned int i = 1; slots[place].length != 0 && slots[place].length != ARENA_DELETED; i++) {
+			place = (place + i) & mask;
+		}
+		used += (slots[place].length == 0);
+		slots[place].offset = offset;
+		slots[place].length = length;
+		slots[place].hash = hash;
+		size++;
+		liveBytes += length;
+	}
+
+	// Перестроить таблицу с ёмкостью newCapacity: удалённые слоты освобождаются,
+	// хеши не пересчитываются. Если удалённых строк в арене больше, чем живых,
+	// живые переписываются в новую арену.
+	void Rebuild(unsigned int newCapacity) {
+		std::vector<Slot> oldSlots(newCapacity);
+		slots.swap(oldSlots);
+		StringArena oldArena;
+		bool compact = deadBytes > liveBytes;
+		if (compact) {
+			arena.swap(oldArena);
+			deadBytes = 0;
+		}
+		SetCapacity(newCapacity);
+
+		for (size_t i = 0; i < oldSlots.size(); i++) {
+			const Slot &slot = oldSlots[i];
+			if (slot.length != 0 && slot.length != ARENA_DELETED) {
+				uint32_t offset = compact ? arena.Add(oldArena.Get(slot.offset), slot.length) : slot.offset;
+				Insert(offset, slot.length, slot.hash);
+			}
+		}
+	}
+
+	void SetCapacity(unsigned int newCapacity) {
+		capacity = newCapacity;
+		mask = capacity - 1;
+		M = 0;
+		for (unsigned int i = capacity; i > 1; i >>= 1, M++) {;}
+		limit = (capacity >> 2) * 3;
+		size = 0;
+		used = 0;
+		liveBytes = 0;
+	}
+
+public:
+	ArenaHashTable() : slots(ARENA_INITIAL_CAPACITY), deadBytes(0), containsEmpty(false) {
+		SetCapacity(ARENA_INITIAL_CAPACITY);
+		a = GetRand64();
+		b = GetRand64();
+		c = (GetRand64() >> 3) | 1; // Должно быть не больше 2^61 - 1
+	}
+
+	bool add(const std::string &s) {
+		// Специальный случай - добавление пустой строки
+		if (s.empty()) {
+			bool added = !containsEmpty;
+			containsEmpty = true;
+			return added;
+		}
+
+		uint32_t hash = Hash(s);
+		if (find_internal(s, hash) != capacity) {
+			return false;
+		}
+		if (used >= limit) {
+			// Удваиваем, если живых строк больше половины предела, иначе хватит очистки
+			Rebuild(size >= limit / 2 ? capacity * 2 : capacity);
+		}
+		uint32_t length = (uint32_t)s.size();
+		Insert(arena.Add(s.data(), length), length, hash);
+		return true;
+	}
+
+	bool del(const std::string &s) {
+		// Специальный случай - удаление пустой строки
+		if (s.empty()) {
+			bool deleted = containsEmpty;
+			containsEmpty = false;
+			return deleted;
+		}
+
+		unsigned int place = find_internal(s, Hash(s));
+		if (place == capacity) {
+			return false;
+		}
+		// Слот остаётся занятым для проб, строка остаётся в арене до уплотнения
+		slots[place].length = ARENA_DELETED;
+		size--;
+		liveBytes -= s.size();
+		deadBytes += s.size();
+		// Удалённых строк стало больше, чем живых (и больше куска) - уплотняем арену
+		if (deadBytes > liveBytes && deadBytes > ARENA_CHUNK) {
+			Rebuild(capacity);
+		}
+		return true;
+	}
+
+	// Возвращаем ПРАВДА, если элемент в таблице
+	bool find(const std::string &s) {
+		if (s.empty()) {
+			return containsEmpty;
+		}
+		return find_internal(s, Hash(s)) != capacity;
+	}
+};
@@ -0,0 +1,6 @@
+#ifndef ARENA_HASH_TABLE_INCLUDED
+#define ARENA_HASH_TABLE_INCLUDED
+
+#include "arena_hash_table.cpp"
+
+#endif
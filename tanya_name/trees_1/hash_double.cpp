@@ -11,7 +11,7 @@
 // Для получения хеша из строки в виде целого числа используем функцию:
 // h(c) = sum(xi * c^i) mod p, 
 // где p = (2^61 - 1) - простое число
-// xi - компоненты строки (по 4 байта)
+// xi - компоненты строки (по 7 байт, см. string_hash.cpp)
 // c - случайное нечётное число < p
 // http://en.wikipedia.org/wiki/Universal_hashing#Hashing_strings
 
@@ -28,23 +28,26 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <memory>
+#include <sys/mman.h>
+#include <unistd.h>
 #include <stdlib.h>     /* srand, rand */
 #include <stdint.h>
 
-// Возвращает целое нечётное случайное 64-бит число
-inline uint64_t GetRand64() {
-	return (((uint64_t)rand()) << 32) + (rand() | 1); // Насильно добавляем единичку в конец 
-													// для гарантии нечётности
-}
+#include "../common/fast_input.h"
+#include "string_hash.h"
+#include "swiss_hash_table.h"
+#include "arena_hash_table.h"
 
-// Получает i mod (2^61 - 1) без операции умножения
-// http://mersenneforum.org/showthread.php?t=1955
-inline uint64_t modP(uint64_t i) {
-	// Константа (2^61 - 1) (в ней 61 единичка)
-	const uint64_t M61 = ((uint64_t)-1) >> 3;
-	i = (i & M61) + (i >> 61);
-	return (i & M61) + (i >> 61);
-}
+// Раскомментировать для таблицы с управляющими байтами и проверкой 16 слотов за раз
+// (swiss_hash_table.cpp) вместо этой
+//#define SWISS_TABLE
+// Раскомментировать для таблицы, хранящей строки подряд в арене, а в слотах - только
+// смещение, длину и хеш (arena_hash_table.cpp)
+//#define ARENA_TABLE
+// Раскомментировать для постепенного удвоения: старая таблица остаётся рядом с новой,
+// и каждая операция переносит из неё REHASH_STEP слотов (нет долгих остановок в add)
+//#define INCREMENTAL_REHASH
 
 
 
@@ -55,7 +58,8 @@ class StringHashTable {
 
 	std::vector<std::string> v;
 	std::vector<bool> deleted; // признак удалённых строк
-	std::vector<uint64_t> coeffs; // Коэффициенты для хеширования
+	std::vector<uint64_t> hashes; // FirstHash строк в слотах: при пробах сравниваем сначала его,
+								  // при удвоении не пересчитываем
 	unsigned int capacity; // ёмкость таблицы
 	unsigned int M; // lg(capacity)
 	unsigned int mask; // битовая маска для быстрого выполнения mod (M единичек в младших битах)
@@ -64,44 +68,74 @@ class StringHashTable {
 	uint64_t a, b, c, d, e; // параметры хеш-функции
 	
 	bool containsEmpty; // Специальный случай - содержит ли таблица пустую строку
+	
+#ifdef INCREMENTAL_REHASH
+// Слотов старой таблицы, переносимых за одну операцию. При 2 перенос заканчивается
+// не позже, чем новая таблица заполнится на 5/8, - до удвоения ещё далеко.
+#define REHASH_STEP 2
+// Слоты удвоенной таблицы создаются заранее, с заполнения на 1/2: в среднем 8 слотов на
+// вставку (от 1/2 до 3/4 - capacity / 4 вставок, как раз 2 * capacity слотов), но
+// кусками по PREPARE_CHUNK. Создание сразу всех слотов (и первое обращение к их страницам
+// памяти) - такая же остановка, как и перенос строк, а по нескольку слотов на каждую
+// вставку - промах страницы в каждой десятой вставке. Крупные редкие куски не попадают
+// даже в 0.1% самых долгих вставок.
+#define PREPARE_CHUNK (1 << 15)
+// Память за концом перенесённой части old возвращается системе кусками не меньше этого
+// (байт): удаление old целиком, со всеми страницами, - тоже остановка
+#define RELEASE_CHUNK (1 << 20)
+	// Таблица до удвоения, пока из неё не перенесены все строки. Строки переносятся с конца,
+	// и перенесённые слоты сразу убираются из v и hashes (pop_back); deleted остаётся
+	// целиком - по нему пробы отличают убранные занятые слоты от пустых.
+	std::unique_ptr<StringHashTable> old;
+	// Заготовки массивов удвоенной таблицы
+	std::vector<std::string> nextV;
+	std::vector<uint64_t> nextHashes;
+	// В old: начало уже возвращённой системе памяти за концом v и hashes
+	char *vReleased;
+	char *hashesReleased;
+	
+	static inline uintptr_t PageSize() {
+		static const uintptr_t size = (uintptr_t)sysconf(_SC_PAGESIZE);
+		return size;
+	}
+	
+	// Вернуть системе целые страницы между концом массива a и released, если их набралось
+	// на RELEASE_CHUNK байт. Объектов за концом массива нет, а память остаётся выделенной
+	// ему, поэтому её можно отдать (madvise) и потом удалить массив как обычно.
+	template<typename T>
+	static void ReleaseTail(const std::vector<T> &a, char *&released) {
+		char *from = (char *)(((uintptr_t)(a.data() + a.size()) + PageSize() - 1) & ~(PageSize() - 1));
+		if (released - from >= RELEASE_CHUNK) {
+			madvise(from, released - from, MADV_DONTNEED);
+			released = from;
+		}
+	}
+	
+	// Конец памяти массива a, округлённый вниз до страницы
+	template<typename T>
+	static char *PagesEnd(const std::vector<T> &a) {
+		return (char *)((uintptr_t)(a.data() + a.capacity()) & ~(PageSize() - 1));
+	}
+#endif
 		
 		
 	// Первичное хеширование
 	inline uint64_t FirstHash(const std::string &s) {
-		unsigned int n = (unsigned int)s.size();
-	
 		// Строка => целое число
 		// h(c) = sum(xi * c^i) mod p
-		uint64_t h = 0;
-		// Группируем буквы по 8 байт
-		for (unsigned int i = 0; i <= ((n - 1) >> 3); i++) {
-			uint64_t buf = 0;
-			for (unsigned int j = (i << 3); j < (i << 3) + 7 && j < n; j++) {
-				buf <<= 8; // освобождаем место в младших 8 битах
-				buf += s[j]; // копируем туда символ
-			}
-			
-			// Суммируем. Храним коэффициенты в массиве для экономии умножений
-			if (i == coeffs.size()) {
-				if (i == 0) {
-					coeffs.push_back(c);
-				} else {
-					// Тут и далее в этой функции при умножении 64-бит чисел
-					// мы теряем старшие 64 бита и получаем только младшие 64.
-					// Это не совсем корректно с точки зрения теории, 
-					// но для практических целей должно быть достаточно.
-					coeffs.push_back(modP(coeffs[i - 1] * c));
-				}
-			}
-			h = modP(h + modP(buf * coeffs[i]));
-		}
+		uint64_t h = WordHash(s, c);
 		
-		//std::cout << h << " " << ((a * h + b) >> (64 - M)) << std::endl;
 		// Целое число => номер ячейки
 		// h(a, b) = (unsigned) (a * x + b) >> (64 - M)
 		return a * h + b;
 	}
 	
+	// Номер ячейки для хеша - старшие M бит. При удвоении ёмкости добавляется один бит,
+	// поэтому хеш строки не меняется и его можно хранить
+	inline unsigned int Place(uint64_t hash) {
+		return (unsigned int) (hash >> (64 - M));
+	}
+	
 	
 	// Вторичное хеширование. i - номер итерации
 	uint64_t secondHashValue;
@@ -118,55 +152,180 @@ class StringHashTable {
 	
 	
 	// Удвоить ёмкость таблицы при заполнении на 3/4
+	// Параметры хеш-функции не меняются: строки переносятся по сохранённым хешам,
+	// без пересчёта FirstHash и без сравнения строк (все они разные)
 	void DoubleCapacity() {
+#ifdef INCREMENTAL_REHASH
+		// Старые массивы отдаём в old, себе берём заготовки удвоенных; строки перенесёт Migrate
+		while (old) {
+			Migrate(); // Предыдущий перенос успевает закончиться, но на всякий случай
+		}
+		Prepare(2 * capacity); // Досоздать слоты, если не успели
+		old.reset(new StringHashTable());
+		old->v.swap(v);
+		old->deleted.swap(deleted);
+		old->hashes.swap(hashes);
+		old->capacity = capacity;
+		old->M = M;
+		old->mask = mask;
+		old->size = size;
+		old->d = d; // Для SecondHash при поиске в old
+		old->e = e;
+		old->vReleased = PagesEnd(old->v);
+		old->hashesReleased = PagesEnd(old->hashes);
+		
+		capacity *= 2;
+		M++;
+		mask = capacity - 1;
+		limit = (capacity >> 2) * 3;
+		size = 0;
+		v.swap(nextV);
+		hashes.swap(nextHashes);
+		nextV.clear();
+		nextHashes.clear();
+		deleted.resize(capacity);
+		return;
+#endif
 		unsigned int oldCapacity = capacity;
 		capacity *= 2;
 		M++;
 		mask = capacity - 1; // M единичек в младших битах
 		limit = (capacity >> 2) * 3; // Битово делим на 4 и умножаем на 3
-		a = GetRand64();
-		b = GetRand64();
-		c = (GetRand64() >> 3) | 1; // Должно быть не больше 2^61 - 1
-		d = GetRand64();
-		e = GetRand64();
 		
 		size = 0;
-		// Увеличить v и deleted в 2 раза
+		// Увеличить v, deleted и hashes в 2 раза
 		std::vector<std::string> oldV(capacity);
 		std::vector<bool> oldDeleted(capacity);
-		// Меняем содержимое текущих векторов с новыми векторами oldV, oldDeleted 
+		std::vector<uint64_t> oldHashes(capacity);
+		// Меняем содержимое текущих векторов с новыми векторами oldV, oldDeleted, oldHashes
 		v.swap(oldV);
 		deleted.swap(oldDeleted);
+		hashes.swap(oldHashes);
 		
-		// Копируем все неудалённые элементы из старого вектора в новый
+		// Переносим все неудалённые элементы из старого вектора в новый
 		for (unsigned int i = 0; i < oldCapacity; i++) {
 			if (!oldDeleted[i] && !oldV[i].empty()) {
-				add(oldV[i]);
+				Insert(oldV[i], oldHashes[i]);
 			}
 		}
 	}
 	
+	// Вставить заведомо отсутствующую строку в первый пустой или удалённый слот
+	void Insert(std::string &s, uint64_t hash) {
+		uint64_t probe = hash;
+		unsigned int place = Place(hash);
+		for (unsigned int i = 1; !v[place].empty(); i++) {
+			probe = SecondHash(probe, i);
+			place = (unsigned int) probe;
+		}
+		v[place].swap(s);
+		deleted[place] = false;
+		hashes[place] = hash;
+		size++;
+	}
+	
+#ifdef INCREMENTAL_REHASH
+	// Перенести из old последние REHASH_STEP слотов и убрать их из массивов old
+	void Migrate() {
+		size_t rest = old->v.size();
+		size_t end = rest > REHASH_STEP ? rest - REHASH_STEP : 0;
+		// Строки попадут в случайные слоты новой таблицы - сначала подгружаем все эти слоты,
+		// чтобы промахи кэша шли одновременно, а не один за другим
+		for (size_t i = end; i < rest; i++) {
+			if (!old->v[i].empty()) {
+				Prefetch(old->hashes[i]);
+			}
+		}
+		while (old->v.size() > end) {
+			// Удалённые строки пустые - их не переносим
+			if (!old->v.back().empty()) {
+				Insert(old->v.back(), old->hashes.back());
+				old->deleted[old->v.size() - 1] = true;
+			}
+			old->v.pop_back();
+			old->hashes.pop_back();
+		}
+		ReleaseTail(old->v, old->vReleased);
+		ReleaseTail(old->hashes, old->hashesReleased);
+		if (old->v.empty()) {
+			old.reset(); // Страницы почти все уже отданы - удаление быстрое
+		}
+	}
+	
+	// Досоздать в заготовках удвоенной таблицы слоты, но не больше count
+	void Prepare(unsigned int count) {
+		size_t n = 2 * (size_t)capacity;
+		if (nextV.capacity() < n) {
+			// Память выделяется сразу, но страницы заполняются по мере создания слотов
+			nextV.reserve(n);
+			nextHashes.reserve(n);
+		}
+		size_t k = nextV.size() + count < n ? nextV.size() + count : n;
+		nextV.resize(k);
+		nextHashes.resize(k);
+	}
+	
+	// Подгрузить в кэш первый слот проб хеша hash (в old он может быть уже убран)
+	inline void Prefetch(uint64_t hash) {
+		unsigned int place = Place(hash);
+		if (place < v.size()) {
+			__builtin_prefetch(&v[place]);
+			__builtin_prefetch(&hashes[place]);
+		}
+	}
+	
+	// Найти строку в old. Найденная строка сразу переносится в новую таблицу
+	// (remove - удаляется), её слот в old становится удалённым.
+	// Слоты за концом v и hashes old уже убраны: занятые при переносе помечены удалёнными,
+	// пустые так и остались пустыми, поэтому пробы кончаются там же, где до переноса.
+	bool FindOld(const std::string &s, uint64_t hash, bool remove) {
+		if (!old) {
+			return false;
+		}
+		unsigned int rest = (unsigned int)old->v.size();
+		uint64_t probe = hash;
+		unsigned int place = old->Place(hash);
+		for (unsigned int i = 1; i <= old->capacity; i++) {
+			if (place >= rest ? !old->deleted[place] : old->v[place].empty() && !old->deleted[place]) {
+				return false;
+			}
+			if (place < rest && old->hashes[place] == hash && old->v[place] == s) {
+				if (!remove) {
+					Insert(old->v[place], hash);
+				}
+				old->v[place].clear();
+				old->deleted[place] = true;
+				return true;
+			}
+			probe = old->SecondHash(probe, i);
+			place = (unsigned int) probe;
+		}
+		return false;
+	}
+#endif
+	
 	// Найти элемент (функция для внутреннего использования)
 	// Возвращает позицию найденного элемента в таблице или capacity, если ничего не найдено
 	// Параметр forInsert - выполняем поиск для вставки элемента в пустую или удалённую ячейку
 	// http://en.wikipedia.org/wiki/Lazy_deletion
-	unsigned int find_internal(const std::string &s, bool forInsert = false) {
+	unsigned int find_internal(const std::string &s, uint64_t hash, bool forInsert = false) {
 		// Находим элемент, если встречаем по пути удалённый - меняем их местами
 		unsigned int delPlace = capacity; // По-умолчанию - не встречено удалённого элемента
 		
-		uint64_t hash = FirstHash(s);
-		unsigned int place = (unsigned int) (hash >> (64 - M));
-		// Условие (!forInsert && deleted[place]) означает, что если мы ищем для вставки
-		// и встретили удалённый элемент, то сразу завершаем поиск
-		for (unsigned int i = 1; !v[place].empty() || (!forInsert && deleted[place]); i++) {
+		uint64_t probe = hash;
+		unsigned int place = Place(hash);
+		// Удалённые слоты проходим и при поиске для вставки: строка может оказаться дальше
+		for (unsigned int i = 1; !v[place].empty() || deleted[place]; i++) {
 			if (deleted[place] && (delPlace == capacity)) {
 				delPlace = place; // Запомнили место первого удалённого слота
 			}
 			
-			if (v[place] == s) {
+			// Строки сравниваем, только если совпали хеши
+			if (hashes[place] == hash && v[place] == s) {
 				// Нашли нужный элемент - меняем с удалённым, возвращаем новую позицию
 				if (delPlace != capacity) {
 					v[delPlace].swap(v[place]);
+					hashes[delPlace] = hash;
 					deleted[delPlace] = false;
 					deleted[place] = true;
 					place = delPlace;
@@ -175,13 +334,13 @@ class StringHashTable {
 			}
 			
 			// Генерируем вторичный хеш c i-й итерацией
-			hash = SecondHash(hash, i);
-			place = (unsigned int) hash;
+			probe = SecondHash(probe, i);
+			place = (unsigned int) probe;
 		}
 		
 		if (forInsert) {
-			// Искали для вставки - возвращаем номер пустого или удалённого слота
-			return place;
+			// Искали для вставки - возвращаем номер первого удалённого или пустого слота
+			return delPlace != capacity ? delPlace : place;
 		} else {
 			// Не нашли элемент - возвращаем capacity
 			return capacity;
@@ -214,6 +373,7 @@ public:
 		size = 0; // Изначально в таблице нет элементов
 		v.resize(INITIAL_CAPACITY);
 		deleted.resize(INITIAL_CAPACITY);
+		hashes.resize(INITIAL_CAPACITY);
 		
 		containsEmpty = false;
 	}
@@ -229,16 +389,38 @@ public:
 			}
 		}
 	
+#ifdef INCREMENTAL_REHASH
+		if (old) {
+			Migrate();
+		}
+		// Готовим следующее удвоение: заготовки отстали от заполнения - досоздаём кусок
+		if (size >= capacity / 2 && nextV.size() < 8 * (size_t)(size - capacity / 2)) {
+			Prepare(PREPARE_CHUNK);
+		}
+#endif
 		// В случае переполнения 3/4 ёмкости удваиваем таблицу
 		if (size >= limit) {
 			DoubleCapacity();
 		}
 		
+		uint64_t hash = FirstHash(s);
+#ifdef INCREMENTAL_REHASH
+		// Строка может быть ещё в старой таблице (искать после удвоения - оно создаёт old).
+		// Слоты в обеих таблицах подгружаем заранее - промахи кэша идут одновременно.
+		if (old) {
+			Prefetch(hash);
+			old->Prefetch(hash);
+		}
+		if (FindOld(s, hash, false)) {
+			return false;
+		}
+#endif
+		
 		// Поиск, куда воткнуть элемент. Слоты с удалёнными строками считаются пустыми.
-		unsigned int place = find_internal(s, true);
+		unsigned int place = find_internal(s, hash, true);
 		
-		// Если элемент есть, то возвращаем false.
-		if (v[place] == s) {
+		// Если элемент есть (вернулся занятый слот), то возвращаем false.
+		if (!v[place].empty() && !deleted[place]) {
 			return false;
 		}
 
@@ -246,6 +428,7 @@ public:
 		size++;
 		v[place] = s;
 		deleted[place] = false;
+		hashes[place] = hash;
 		
 		return true;
 	}
@@ -263,13 +446,24 @@ public:
 	
 		// Находим элемент, стираем, помечаем как удалённый
 		// При поиске слоты с удалёнными элементами считаем заполненными
-		unsigned int place = find_internal(s);
+		uint64_t hash = FirstHash(s);
+#ifdef INCREMENTAL_REHASH
+		if (old) {
+			Migrate();
+		}
+#endif
+		unsigned int place = find_internal(s, hash);
 		if (place != capacity) {
 			// Нашли - удаляем
 			deleted[place] = true;
 			v[place].clear();
 			return true;
 		}
+#ifdef INCREMENTAL_REHASH
+		if (FindOld(s, hash, true)) {
+			return true;
+		}
+#endif
 		
 		// не нашли - возвращаем ЛОЖЬ
 		return false;
@@ -282,7 +476,15 @@ public:
 			return containsEmpty;
 		}
 		
-		return find_internal(s) != capacity;
+#ifdef INCREMENTAL_REHASH
+		uint64_t hash = FirstHash(s);
+		if (old) {
+			Migrate();
+		}
+		return find_internal(s, hash) != capacity || FindOld(s, hash, false);
+#else
+		return find_internal(s, FirstHash(s)) != capacity;
+#endif
 	}
 	
 };
@@ -296,9 +498,15 @@ int main()
 	// Размер массива чисел
 	char op;
 	std::string word;
+#ifdef SWISS_TABLE
+	SwissHashTable t;
+#elif defined(ARENA_TABLE)
+	ArenaHashTable t;
+#else
 	StringHashTable t;
-	while( !std::cin.eof()) {
-		std::cin >> op >> word;
+#endif
+	FastInput in;
+	while (in.ReadCommand(op, word)) {
 		// Для теста: вывод всех входных данных
 		//std::cout << op << ", '" << word << "'" << std::endl;
 		
@@ -10,7 +10,7 @@
 // Для получения хеша из строки в виде целого числа используем функцию:
 // h(c) = sum(xi * c^i) mod p, 
 // где p = (2^61 - 1) - простое число
-// xi - компоненты строки (по 4 байта)
+// xi - компоненты строки (по 7 байт, см. string_hash.cpp)
 // c - случайное нечётное число < p
 // http://en.wikipedia.org/wiki/Universal_hashing#Hashing_strings
 
@@ -30,20 +30,17 @@
 #include <stdlib.h>     /* srand, rand */
 #include <stdint.h>
 
-// Возвращает целое нечётное случайное 64-бит число
-inline uint64_t GetRand64() {
-	return (((uint64_t)rand()) << 32) + (rand() | 1); // Насильно добавляем единичку в конец 
-													// для гарантии нечётности
-}
+#include "../common/fast_input.h"
+#include "string_hash.h"
+#include "swiss_hash_table.h"
+#include "arena_hash_table.h"
 
-// Получает i mod (2^61 - 1) без операции умножения
-// http://mersenneforum.org/showthread.php?t=1955
-inline uint64_t modP(uint64_t i) {
-	// Константа (2^61 - 1) (в ней 61 единичка)
-	const uint64_t M61 = ((uint64_t)-1) >> 3;
-	i = (i & M61) + (i >> 61);
-	return (i & M61) + (i >> 61);
-}
+// Раскомментировать для таблицы с управляющими байтами и проверкой 16 слотов за раз
+// (swiss_hash_table.cpp) вместо этой
+//#define SWISS_TABLE
+// Раскомментировать для таблицы, хранящей строки подряд в арене, а в слотах - только
+// смещение, длину и хеш (arena_hash_table.cpp)
+//#define ARENA_TABLE
 
 
 
@@ -54,7 +51,8 @@ class StringHashTable {
 
 	std::vector<std::string> v;
 	std::vector<bool> deleted; // признак удалённых строк
-	std::vector<uint64_t> coeffs; // Коэффициенты для хеширования
+	std::vector<uint64_t> hashes; // FirstHash строк в слотах: при пробах сравниваем сначала его,
+								  // при удвоении не пересчитываем
 	unsigned int capacity; // ёмкость таблицы
 	unsigned int M; // lg(capacity)
 	unsigned int mask; // битовая маска для быстрого выполнения mod (M единичек в младших битах)
@@ -65,38 +63,21 @@ class StringHashTable {
 	bool containsEmpty; // Специальный случай - содержит ли таблица пустую строку
 		
 	// Первичное хеширование
-	inline unsigned int FirstHash(const std::string &s) {
-		unsigned int n = (unsigned int)s.size();
-	
+	inline uint64_t FirstHash(const std::string &s) {
 		// Строка => целое число
 		// h(c) = sum(xi * c^i) mod p
-		uint64_t h = 0;
-		// Группируем буквы по 8 байт
-		for (unsigned int i = 0; i <= ((n - 1) >> 3); i++) {
-			uint64_t buf = 0;
-			for (unsigned int j = (i << 3); j < (i << 3) + 7 && j < n; j++) {
-				buf <<= 8; // освобождаем место в младших 8 битах
-				buf += s[j]; // копируем туда символ
-			}
-			
-			// Суммируем. Храним коэффициенты в массиве для экономии умножений
-			if (i == coeffs.size()) {
-				if (i == 0) {
-					coeffs.push_back(c);
-				} else {
-					// Тут и далее в этой функции при умножении 64-бит чисел
-					// мы теряем старшие 64 бита и получаем только младшие 64.
-					// Это не совсем корректно с точки зрения теории, 
-					// но для практических целей должно быть достаточно.
-					coeffs.push_back(modP(coeffs[i - 1] * c));
-				}
-			}
-			h = modP(h + modP(buf * coeffs[i]));
-		}
+		uint64_t h = WordHash(s, c);
 		
 		// Целое число => номер ячейки
 		// h(a, b) = (unsigned) (a * x + b) >> (64 - M)
-		return (unsigned int) ((a * h + b) >> (64 - M));
+		// Номер ячейки - старшие M бит, см. Place
+		return a * h + b;
+	}
+	
+	// Номер ячейки для хеша - старшие M бит. При удвоении ёмкости добавляется один бит,
+	// поэтому хеш строки не меняется и его можно хранить
+	inline unsigned int Place(uint64_t hash) {
+		return (unsigned int) (hash >> (64 - M));
 	}
 	
 	// Вторичное хеширование. i - номер итерации
@@ -106,52 +87,65 @@ class StringHashTable {
 	}
 	
 	// Удвоить ёмкость таблицы при заполнении на 3/4
+	// Параметры хеш-функции не меняются: строки переносятся по сохранённым хешам,
+	// без пересчёта FirstHash и без сравнения строк (все они разные)
 	void DoubleCapacity() {
 		unsigned int oldCapacity = capacity;
 		capacity *= 2;
 		M++;
 		mask = capacity - 1; // M единичек в младших битах
 		limit = (capacity >> 2) * 3; // Битово делим на 4 и умножаем на 3
-		a = GetRand64();
-		b = GetRand64();
-		c = (GetRand64() >> 3) | 1; // Должно быть не больше 2^61 - 1
 		
 		size = 0;
-		// Увеличить v и deleted в 2 раза
+		// Увеличить v, deleted и hashes в 2 раза
 		std::vector<std::string> oldV(capacity);
 		std::vector<bool> oldDeleted(capacity);
-		// Меняем содержимое текущих векторов с новыми векторами oldV, oldDeleted 
+		std::vector<uint64_t> oldHashes(capacity);
+		// Меняем содержимое текущих векторов с новыми векторами oldV, oldDeleted, oldHashes
 		v.swap(oldV);
 		deleted.swap(oldDeleted);
+		hashes.swap(oldHashes);
 		
-		// Копируем все неудалённые элементы из старого вектора в новый
+		// Переносим все неудалённые элементы из старого вектора в новый
 		for (unsigned int i = 0; i < oldCapacity; i++) {
 			if (!oldDeleted[i] && !oldV[i].empty()) {
-				add(oldV[i]);
+				Insert(oldV[i], oldHashes[i]);
 			}
 		}
 	}
 	
+	// Вставить заведомо отсутствующую строку в первый пустой слот (удалённых в таблице нет)
+	void Insert(std::string &s, uint64_t hash) {
+		unsigned int place = Place(hash);
+		for (unsigned int i = 1; !v[place].empty(); i++) {
+			place = SecondHash(place, i);
+		}
+		v[place].swap(s);
+		hashes[place] = hash;
+		size++;
+	}
+	
 	// Найти элемент (функция для внутреннего использования)
 	// Возвращает позицию найденного элемента в таблице или capacity, если ничего не найдено
 	// Параметр forInsert - выполняем поиск для вставки элемента в пустую или удалённую ячейку
 	// http://en.wikipedia.org/wiki/Lazy_deletion
-	unsigned int find_internal(const std::string &s, bool forInsert = false) {
+	unsigned int find_internal(const std::string &s, uint64_t hash, bool forInsert = false) {
 		// Находим элемент, если встречаем по пути удалённый - меняем их местами
 		unsigned int delPlace = capacity; // По-умолчанию - не встречено удалённого элемента
 		
-		unsigned int place = FirstHash(s);
-		// Условие (!forInsert && deleted[place]) означает, что если мы ищем для вставки
-		// и встретили удалённый элемент, то сразу завершаем поиск
-		for (unsigned int i = 1; !v[place].empty() || (!forInsert && deleted[place]); i++) {
+		unsigned int place = Place(hash);
+		// Удалённые слоты проходим и при поиске для вставки: строка может оказаться дальше
+		for (unsigned int i = 1; !v[place].empty() || deleted[place]; i++) {
 			if (deleted[place] && (delPlace == capacity)) {
 				delPlace = place; // Запомнили место первого удалённого слота
 			}
 			
-			if (v[place] == s) {
+			// Строки сравниваем, только если совпали хеши
+			if (hashes[place] == hash && v[place] == s) {
 				// Нашли нужный элемент - меняем с удалённым, возвращаем новую позицию
 				if (delPlace != capacity) {
 					v[delPlace].swap(v[place]);
+					hashes[delPlace] = hash;
 					deleted[delPlace] = false;
 					deleted[place] = true;
 					place = delPlace;
@@ -164,8 +158,8 @@ class StringHashTable {
 		}
 		
 		if (forInsert) {
-			// Искали для вставки - возвращаем номер пустого или удалённого слота
-			return place;
+			// Искали для вставки - возвращаем номер первого удалённого или пустого слота
+			return delPlace != capacity ? delPlace : place;
 		} else {
 			// Не нашли элемент - возвращаем capacity
 			return capacity;
@@ -194,6 +188,7 @@ public:
 		size = 0; // Изначально в таблице нет элементов
 		v.resize(INITIAL_CAPACITY);
 		deleted.resize(INITIAL_CAPACITY);
+		hashes.resize(INITIAL_CAPACITY);
 		
 		containsEmpty = false;
 	}
@@ -215,10 +210,11 @@ public:
 		}
 		
 		// Поиск, куда воткнуть элемент. Слоты с удалёнными строками считаются пустыми.
-		unsigned int place = find_internal(s, true);
+		uint64_t hash = FirstHash(s);
+		unsigned int place = find_internal(s, hash, true);
 		
-		// Если элемент есть, то возвращаем false.
-		if (v[place] == s) {
+		// Если элемент есть (вернулся занятый слот), то возвращаем false.
+		if (!v[place].empty() && !deleted[place]) {
 			return false;
 		}
 
@@ -226,6 +222,7 @@ public:
 		size++;
 		v[place] = s;
 		deleted[place] = false;
+		hashes[place] = hash;
 		
 		return true;
 	}
@@ -243,7 +240,7 @@ public:
 	
 		// Находим элемент, стираем, помечаем как удалённый
 		// При поиске слоты с удалёнными элементами считаем заполненными
-		unsigned int place = find_internal(s);
+		unsigned int place = find_internal(s, FirstHash(s));
 		if (place != capacity) {
 			// Нашли - удаляем
 			deleted[place] = true;
@@ -262,7 +259,7 @@ public:
 			return containsEmpty;
 		}
 		
-		return find_internal(s) != capacity;
+		return find_internal(s, FirstHash(s)) != capacity;
 	}
 	
 };
@@ -276,9 +273,15 @@ int main()
 	// Размер массива чисел
 	char op;
 	std::string word;
+#ifdef SWISS_TABLE
+	SwissHashTable t;
+#elif defined(ARENA_TABLE)
+	ArenaHashTable t;
+#else
 	StringHashTable t;
-	while( !std::cin.eof()) {
-		std::cin >> op >> word;
+#endif
+	FastInput in;
+	while (in.ReadCommand(op, word)) {
 		// Для теста: вывод всех входных данных
 		//std::cout << op << ", '" << word << "'" << std::endl;
 		
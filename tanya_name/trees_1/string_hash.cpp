@@ -0,0 +1,168 @@
+// Хеширование строк для хеш-таблиц trees_1
+// h(c) = sum(xi * c^i) mod p,
+// где p = (2^61 - 1) - простое число
+// xi - компоненты строки (куски по 7 байт)
+// c - случайное нечётное число < p
+// http://en.wikipedia.org/wiki/Universal_hashing#Hashing_strings
+//
+// WordHash читает строку по 8 байт за раз (невыровненно), но кусок - 7 байт (56 бит):
+// тогда каждый xi < p и многочлен точный, а произведения берутся полностью (128 бит)
+// и приводятся по модулю p. Для двух разных строк длины не больше L вероятность
+// совпадения хешей (по случайному c) не больше (L / 7 + 1) / p.
+// Для длинных строк - 4 независимые цепочки умножений (см. WordHashLanes).
+// PolynomialHash - прежний вариант (теряет старшие биты произведений и пропускает
+// каждый 8-й байт), оставлен для сравнения в bench/string_hash_bench.cpp.
+#include <vector>
+#include <string>
+#include <string.h>
+#include <stdlib.h>     /* srand, rand */
+#include <stdint.h>
+
+// Со строк такой длины (в байтах) WordHash считает в 4 цепочки
+#define WORD_HASH_LANES_FROM 64
+
+// Возвращает целое нечётное случайное 64-бит число
+inline uint64_t GetRand64() {
+	return (((uint64_t)rand()) << 32) + (rand() | 1); // Насильно добавляем единичку в конец
+													// для гарантии нечётности
+}
+
+// Получает i mod (2^61 - 1) без операции умножения
+// http://mersenneforum.org/showthread.php?t=1955
+inline uint64_t modP(uint64_t i) {
+	// Константа (2^61 - 1) (в ней 61 единичка)
+	const uint64_t M61 = ((uint64_t)-1) >> 3;
+	i = (i & M61) + (i >> 61);
+	return (i & M61) + (i >> 61);
+}
+
+// Строка => целое число: h(c) = sum(xi * c^i) mod p.
+// coeffs - уже вычисленные степени c (дополняется по мере надобности).
+inline uint64_t PolynomialHash(const std::string &s, uint64_t c, std::vector<uint64_t> &coeffs) {
+	unsigned int n = (unsigned int)s.size();
+
+	uint64_t h = 0;
+	// Группируем буквы по 8 байт
+	for (unsigned int i = 0; i <= ((n - 1) >> 3); i++) {
+		uint64_t buf = 0;
+		for (unsigned int j = (i << 3); j < (i << 3) + 7 && j < n; j++) {
+			buf <<= 8; // освобождаем место в младших 8 битах
+			buf += s[j]; // копируем туда символ
+		}
+
+		// Суммируем. Храним коэффициенты в массиве для экономии умножений
+		if (i == coeffs.size()) {
+			if (i == 0) {
+				coeffs.push_back(c);
+			} else {
+				// Тут и далее в этой функции при умножении 64-бит чисел
+				// мы теряем старшие 64 бита и получаем только младшие 64.
+				// Это не совсем корректно с точки зрения теории,
+				// но для практических целей должно быть достаточно.
+				coeffs.push_back(modP(coeffs[i - 1] * c));
+			}
+		}
+		h = modP(h + modP(buf * coeffs[i]));
+	}
+	return h;
+}
+
+// Модуль p = 2^61 - 1
+#define P61 (((uint64_t)-1) >> 3)
+// Младшие 7 байт слова
+#define LOW56 (((uint64_t)-1) >> 8)
+
+// x * y mod (2^61 - 1) без потерь: полное 128-бит произведение, 2^61 = 1 (mod p).
+// x, y < 2^62; результат < 2^61 + 4 (не обязательно < p)
+inline uint64_t MulModP(uint64_t x, uint64_t y) {
+	__uint128_t r = (__uint128_t)x * y;
+	uint64_t h = ((uint64_t)r & P61) + (uint64_t)(r >> 61);
+	return (h & P61) + (h >> 61);
+}
+
+// 8 и 4 байта с адреса p (невыровненно)
+inline uint64_t Load64(const char *p) {
+	uint64_t x;
+	memcpy(&x, p, sizeof(x));
+	return x;
+}
+
+inline uint32_t Load32(const char *p) {
+	uint32_t x;
+	memcpy(&x, p, sizeof(x));
+	return x;
+}
+
+// Последний кусок - r = 1..7 байт, заканчивающиеся в p + n. Читается без побайтового
+// цикла: перекрывающимися загрузками внутри строки. В старший (8-й) байт куска
+// записывается r - так строки, отличающиеся нулями в конце, различаются.
+inline uint64_t LastChunk(const char *p, size_t n, size_t r) {
+	uint64_t x;
+	if (n >= 8) {
+		x = Load64(p + n - 8) >> (8 * (8 - r));
+	} else if (n >= 4) {
+		// Строка целиком, r = n: первые 4 байта и последние 4 (пересекаются)
+		x = Load32(p) | ((uint64_t)Load32(p + n - 4) << (8 * (n - 4)));
+	} else {
+		// 1..3 байта: первый, средний и последний
+		x = (uint64_t)(unsigned char)p[0] | ((uint64_t)(unsigned char)p[n >> 1] << (8 * (n >> 1)))
+			| ((uint64_t)(unsigned char)p[n - 1] << (8 * (n - 1)));
+	}
+	return x | ((uint64_t)r << 56);
+}
+
+// Продолжить схему Горнера h = (h + xi) * c с байта pos до конца строки
+inline uint64_t WordHashTail(const char *p, size_t n, size_t pos, uint64_t h, uint64_t c) {
+	// Пока можно читать 8 байт - кусок из первых 7
+	for (; pos + 8 <= n; pos += 7) {
+		h = MulModP(h + (Load64(p + pos) & LOW56), c);
+	}
+	// Остаток - 1..7 байт (0 - только у пустой строки)
+	if (pos < n) {
+		h = MulModP(h + LastChunk(p, n, n - pos), c);
+	}
+	// Приводим к [0, p)
+	h = modP(h);
+	return h >= P61 ? h - P61 : h;
+}
+
+// Строка => целое число < p: h(c) = (c^k + sum(xi * c^(k - i + 1))) mod p, i = 1..k,
+// одна цепочка умножений. Старший член c^k (начальное h = 1) различает строки с
+// разным числом кусков, даже если первые куски нулевые.
+inline uint64_t WordHashSerial(const char *p, size_t n, uint64_t c) {
+	return WordHashTail(p, n, 0, 1, c);
+}
+
+// То же значение, что WordHashSerial, но в 4 цепочки: цепочка j берёт куски j, j + 4, ...
+// и умножается на c^4. Каждое умножение ждёт предыдущего в своей цепочке, так что 4
+// цепочки выполняются одновременно. В конце h = sum(lane_j * c^(4 - j)), дальше - как обычно.
+// (Векторные команды SSE2/AVX2 не умеют умножать 64 x 64 бит, поэтому цепочки - скалярные.)
+inline uint64_t WordHashLanes(const char *p, size_t n, uint64_t c) {
+	// 4 куска по 7 байт; последний читается 8 байтами
+	if (n < 29) {
+		return WordHashSerial(p, n, c);
+	}
+	uint64_t c2 = modP(MulModP(c, c));
+	uint64_t c3 = modP(MulModP(c2, c));
+	uint64_t c4 = modP(MulModP(c2, c2));
+	// Начальная единица WordHashSerial - прибавка к первому куску
+	uint64_t h0 = (Load64(p) & LOW56) + 1;
+	uint64_t h1 = Load64(p + 7) & LOW56;
+	uint64_t h2 = Load64(p + 14) & LOW56;
+	uint64_t h3 = Load64(p + 21) & LOW56;
+	size_t pos = 28;
+	for (; pos + 29 <= n; pos += 28) {
+		h0 = MulModP(h0, c4) + (Load64(p + pos) & LOW56);
+		h1 = MulModP(h1, c4) + (Load64(p + pos + 7) & LOW56);
+		h2 = MulModP(h2, c4) + (Load64(p + pos + 14) & LOW56);
+		h3 = MulModP(h3, c4) + (Load64(p + pos + 21) & LOW56);
+	}
+	uint64_t h = MulModP(h0, c4) + MulModP(h1, c3) + MulModP(h2, c2) + MulModP(h3, c);
+	return WordHashTail(p, n, pos, modP(h), c);
+}
+
+// Строка => целое число < p
+inline uint64_t WordHash(const std::string &s, uint64_t c) {
+	return s.size() >= WORD_HASH_LANES_FROM ? WordHashLanes(s.data(), s.size(), c)
+		: WordHashSerial(s.data(), s.size(), c);
+}
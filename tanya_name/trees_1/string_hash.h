@@ -0,0 +1,6 @@
+#ifndef STRING_HASH_INCLUDED
+#define STRING_HASH_INCLUDED
+
+#include "string_hash.cpp"
+
+#endif
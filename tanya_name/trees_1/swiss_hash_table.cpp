@@ -0,0 +1,210 @@
+// Хеш-таблица строк с управляющими байтами (в духе SwissTable)
+// В StringHashTable каждая проба - сравнение 32-байтовой std::string и бит из
+// std::vector<bool>, и всё это в разных местах памяти. Здесь рядом со строками хранится
+// отдельный массив управляющих байтов, по одному на слот:
+//   CTRL_EMPTY (-128) - пустой слот, CTRL_DELETED (-2) - удалённый (ленивое удаление),
+//   0..127 - слот занят, значение - 7 бит хеша строки (H2).
+// Слоты разбиты на группы по SWISS_GROUP_SIZE = 16. Старшие биты хеша (H1) выбирают
+// группу, и вся группа проверяется за несколько команд SSE2: сравнение 16 байтов с H2
+// даёт маску слотов-кандидатов, и строки сравниваются только в них (лишнее сравнение -
+// в среднем одно на 128 занятых слотов).
+// Пустой слот в группе означает, что строки в таблице нет. Группы перебираются
+// квадратичным пробированием: g(i) = g(i - 1) + i (mod число групп) обходит все группы.
+// Перехеширование (с удвоением, если нужно) - когда заняты или удалены 3/4 слотов.
+// Начальная ёмкость - одна группа, 16 слотов.
+// https://abseil.io/about/design/swisstables
+#include <vector>
+#include <string>
+#include <utility>
+#include <stdint.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "string_hash.h"
+
+// Слотов в группе
+#define SWISS_GROUP_SIZE 16
+// Управляющие байты пустого и удалённого слота
+#define CTRL_EMPTY ((int8_t)-128)
+#define CTRL_DELETED ((int8_t)-2)
+
+class SwissHashTable {
+	std::vector<int8_t> ctrl; // Управляющие байты
+	std::vector<std::string> v;
+	unsigned int capacity; // ёмкость таблицы (кратна SWISS_GROUP_SIZE)
+	unsigned int groupMask; // число групп - 1
+	unsigned int G; // lg(число групп)
+	unsigned int size; // заполненность таблицы
+	unsigned int used; // занятые и удалённые слоты
+	unsigned int limit; // Предел used (3/4 от capacity)
+	uint64_t a, b, c; // параметры хеш-функции
+
+	bool containsEmpty; // Специальный случай - содержит ли таблица пустую строку
+
+	inline uint64_t Hash(const std::string &s) {
+		return a * WordHash(s, c) + b;
+	}
+
+	// Номер первой группы - старшие биты хеша
+	inline unsigned int H1(uint64_t hash) const {
+		return G == 0 ? 0 : (unsigned int)(hash >> (64 - G));
+	}
+
+	// Байт для управляющего массива - 7 бит из середины хеша (не пересекаются с H1)
+	static inline int8_t H2(uint64_t hash) {
+		return (int8_t)((hash >> 25) & 0x7F);
+	}
+
+	// Маска слотов группы g, управляющий байт которых равен x
+	inline unsigned int Match(unsigned int g, int8_t x) const {
+		const int8_t *p = &ctrl[g * SWISS_GROUP_SIZE];
+#ifdef __SSE2__
+		__m128i group = _mm_loadu_si128((const __m128i *)p);
+		return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(x)));
+#else
+		unsigned int m = 0;
+		for (int i = 0; i < SWISS_GROUP_SIZE; i++) {
+			m |= (unsigned int)(p[i] == x) << i;
+		}
+		return m;
+#endif
+	}
+
+	// Маска пустых и удалённых слотов группы g (у них старший бит байта - единица)
+	inline unsigned int MatchFree(unsigned int g) const {
+		const int8_t *p = &ctrl[g * SWISS_GROUP_SIZE];
+#ifdef __SSE2__
+		return (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)p));
+#else
+		unsigned int m = 0;
+		for (int i = 0; i < SWISS_GROUP_SIZE; i++) {
+			m |= (unsigned int)(p[i] < 0) << i;
+		}
+		return m;
+#endif
+	}
+
+	// Слот со строкой s или capacity, если её нет
+	unsigned int find_internal(const std::string &s, uint64_t hash) const {
+		int8_t h2 = H2(hash);
+		unsigned int g = H1(hash);
+		for (unsigned int i = 1; ; i++) {
+			for (unsigned int m = Match(g, h2); m != 0; m &= m - 1) {
+				unsigned int place = g * SWISS_GROUP_SIZE + __builtin_ctz(m);
+				if (v[place] == s) {
+					return place;
+				}
+			}
+			if (Match(g, CTRL_EMPTY) != 0) {
+				return capacity;
+			}
+			g = (g + i) & groupMask;
+		}
+	}
+
+	// Первый пустой или удалённый слот на пути строки с хешем hash
+	unsigned int FindFree(uint64_t hash) const {
+		unsigned int g = H1(hash);
+		for (unsigned int i = 1; ; i++) {
+			unsigned int m = MatchFree(g);
+			if (m != 0) {
+				return g * SWISS_GROUP_SIZE + __builtin_ctz(m);
+			}
+			g = (g + i) & groupMask;
+		}
+	}
+
+	// Вставка заведомо отсутствующей строки
+	void Insert(std::string &&s, uint64_t hash) {
+		unsigned int place = FindFree(hash);
+		used += (ctrl[place] == CTRL_EMPTY);
+		ctrl[place] = H2(hash);
+		v[place] = std::move(s);
+		size++;
+	}
+
+	// Перестроить таблицу: удалённые слоты освобождаются, ёмкость удваивается,
+	// если живых строк больше половины предела (иначе хватит очистки от удалённых)
+	void Rehash() {
+		unsigned int newCapacity = (size >= limit / 2) ? capacity * 2 : capacity;
+		std::vector<int8_t> oldCtrl(newCapacity, CTRL_EMPTY);
+		std::vector<std::string> oldV(newCapacity);
+		ctrl.swap(oldCtrl);
+		v.swap(oldV);
+		unsigned int oldCapacity = capacity;
+		SetCapacity(newCapacity);
+
+		for (unsigned int i = 0; i < oldCapacity; i++) {
+			if (oldCtrl[i] >= 0) {
+				uint64_t hash = Hash(oldV[i]);
+				Insert(std::move(oldV[i]), hash);
+			}
+		}
+	}
+
+	void SetCapacity(unsigned int newCapacity) {
+		capacity = newCapacity;
+		groupMask = capacity / SWISS_GROUP_SIZE - 1;
+		G = 0;
+		for (unsigned int i = capacity / SWISS_GROUP_SIZE; i > 1; i >>= 1, G++) {;}
+		limit = (capacity >> 2) * 3;
+		size = 0;
+		used = 0;
+	}
+
+public:
+	SwissHashTable() : ctrl(SWISS_GROUP_SIZE, CTRL_EMPTY), v(SWISS_GROUP_SIZE), containsEmpty(false) {
+		SetCapacity(SWISS_GROUP_SIZE);
+		a = GetRand64();
+		b = GetRand64();
+		c = (GetRand64() >> 3) | 1; // Должно быть не больше 2^61 - 1
+	}
+
+	bool add(const std::string &s) {
+		// Специальный случай - добавление пустой строки
+		if (s.empty()) {
+			bool added = !containsEmpty;
+			containsEmpty = true;
+			return added;
+		}
+
+		uint64_t hash = Hash(s);
+		if (find_internal(s, hash) != capacity) {
+			return false;
+		}
+		if (used >= limit) {
+			Rehash();
+		}
+		Insert(std::string(s), hash);
+		return true;
+	}
+
+	bool del(const std::string &s) {
+		// Специальный случай - удаление пустой строки
+		if (s.empty()) {
+			bool deleted = containsEmpty;
+			containsEmpty = false;
+			return deleted;
+		}
+
+		unsigned int place = find_internal(s, Hash(s));
+		if (place == capacity) {
+			return false;
+		}
+		// Слот остаётся занятым для проб (CTRL_DELETED), память строки освобождаем
+		ctrl[place] = CTRL_DELETED;
+		std::string().swap(v[place]);
+		size--;
+		return true;
+	}
+
+	// Возвращаем ПРАВДА, если элемент в таблице
+	bool find(const std::string &s) {
+		if (s.empty()) {
+			return containsEmpty;
+		}
+		return find_internal(s, Hash(s)) != capacity;
+	}
+};
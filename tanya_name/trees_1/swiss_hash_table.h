@@ -0,0 +1,6 @@
+#ifndef SWISS_HASH_TABLE_INCLUDED
+#define SWISS_HASH_TABLE_INCLUDED
+
+#include "swiss_hash_table.cpp"
+
+#endif
@@ -5,6 +5,8 @@
 // http://www.cplusplus.com/reference/memory/auto_ptr/ 
 #include <memory>
 
+#include "../common/fast_input.h"
+
 
 class NaiveTree {
 	// Объявление этой структуры не видно извне.
@@ -172,13 +174,13 @@ int main()
 	// по цепной реакции освободит все элементы из-под умных указателей.
 	NaiveTree T;
 	
+	FastInput in;
 	// Размер массива чисел
 	int n = 0;
-	std::cin >> n;
-	while( !std::cin.eof() && n > 0 ) {
+	in.Read(n);
+	int i = 0;
+	while (n > 0 && in.Read(i)) {
 		--n;
-		int i = 0;
-		std::cin >> i;
 		// Вставить элемент в дерево
 		T.add(i);
 	}
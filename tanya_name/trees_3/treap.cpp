@@ -8,6 +8,7 @@
 
 // Используем реализацию наивного дерева из задачи #2
 #include "naive_tree.h"
+#include "../common/fast_input.h"
 
 
 class Treap {
@@ -236,13 +237,13 @@ int main()
 	NaiveTree NT;
 	Treap Tr;
 	
+	FastInput in;
 	// Размер массива чисел
 	int n = 0;
-	std::cin >> n;
-	while( !std::cin.eof() && n > 0 ) {
+	in.Read(n);
+	int key = 0, priority = 0;
+	while (n > 0 && in.ReadPair(key, priority)) {
 		--n;
-		int key = 0, priority = 0;
-		std::cin >> key >> priority;
 		// Вставить элемент в деревья
 		NT.add(key);
 		Tr.add(key, priority);
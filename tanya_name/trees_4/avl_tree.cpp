@@ -6,6 +6,8 @@
 // http://www.cplusplus.com/reference/memory/auto_ptr/ 
 #include <memory>
 
+#include "../common/fast_input.h"
+
 
 class AVLTree {
 	// Объявление этой структуры не видно извне.
@@ -305,9 +307,9 @@ int main()
 	// Дерево. При выходе из программы будет автоматически уничтожено.
 	AVLTree AT;
 	
-	while (!std::cin.eof()) {
-		int key = 0;
-		std::cin >> key;
+	FastInput in;
+	int key = 0;
+	while (in.Read(key)) {
 		// Вставить, если ключ положительный; удалить, если отрицательный
 		if (key > 0) {
 			AT.add(key);
@@ -13,6 +13,8 @@
 // http://www.cplusplus.com/reference/memory/auto_ptr/ 
 #include <memory>
 
+#include "../common/fast_input.h"
+
 
 class AVLTree {
 	// Объявление этой структуры не видно извне.
@@ -353,12 +355,12 @@ int main()
 	// Дерево. При выходе из программы будет автоматически уничтожено.
 	AVLTree AT;
 	
+	FastInput in;
 	int n = 0;
-	std::cin >> n;
-	while (!std::cin.eof() && n > 0) {
+	in.Read(n);
+	int key = 0, k = 0;
+	while (n > 0 && in.ReadPair(key, k)) {
 		--n;
-		int key = 0, k = 0;
-		std::cin >> key >> k;
 		// Вставить, если ключ положительный; удалить, если отрицательный
 		if (key > 0) {
 			AT.add(key);
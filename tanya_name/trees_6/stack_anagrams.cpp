@@ -29,6 +29,8 @@
 #include <stack>
 #include <string>
 
+#include "../common/fast_input.h"
+
 // out - то слово, которое должны получить
 // in - входное слово
 // it - итератор для входного слова (указатель на текущую позицию в слове)
@@ -71,7 +73,9 @@ int main()
 	
 	// Вход - два слова
 	std::string in, out;
-	std::cin >> in >> out;
+	FastInput input;
+	input.Read(in);
+	input.Read(out);
 	
 	// Вывод входных данных
 	//std::cout << in << " " << out << std::endl;
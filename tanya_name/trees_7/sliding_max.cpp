@@ -12,6 +12,8 @@
 #include <vector>
 #include <deque>
 
+#include "../common/fast_input.h"
+
 
 void PrintSlidingMax(std::vector<int> &A, int w) {
 	int n = (int)A.size();
@@ -42,20 +44,15 @@ int main()
 	freopen("test.txt", "r", stdin);
 	
 	
+	FastInput in;
 	// Размер массива чисел
 	int n = 0;
-	std::cin >> n;
+	in.Read(n);
 	std::vector<int> v;
-	v.reserve(n); // Будет n чисел
-	while( !std::cin.eof() && n > 0 ) {
-		--n;
-		int i = 0;
-		std::cin >> i;
-		v.push_back(i);
-	}
+	in.Read(v, n); // Будет n чисел - память под них выделяется сразу
 	// Размер окна
 	int k = 0;
-	std::cin >> k;
+	in.Read(k);
 	
 	// Вывод входных данных
 	// std::cout << n << " " << k << std::endl;